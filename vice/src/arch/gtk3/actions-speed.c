@@ -35,7 +35,9 @@
 
 #include "basedialogs.h"
 #include "debug_gtk3.h"
+#include "mainlock.h"
 #include "resources.h"
+#include "types.h"
 #include "ui.h"
 #include "uiactions.h"
 #include "uimenu.h"
@@ -57,15 +59,41 @@ static void pause_toggle_action(void)
 }
 
 
+/** \brief  Update the warp menu item, UI thread
+ *
+ * \param[in]   param   warp mode as applied by the VICE thread (int)
+ *
+ * \return FALSE (run once)
+ */
+static gboolean warp_mode_update_menu_impl(gpointer param)
+{
+    ui_set_check_menu_item_blocked_by_action(ACTION_WARP_MODE_TOGGLE,
+                                             (gboolean)vice_ptr_to_int(param));
+    return FALSE;
+}
+
+
+/** \brief  Toggle warp mode on the VICE thread
+ *
+ * \param[in]   param   unused
+ */
+static void warp_mode_toggle_cb(void *param)
+{
+    vsync_set_warp_mode(!vsync_get_warp_mode());
+    gdk_threads_add_timeout(0, warp_mode_update_menu_impl,
+                            int_to_void_ptr(vsync_get_warp_mode()));
+}
+
+
 /** \brief  Toggle warp mode
  *
- * Toggles warp mode and updates UI elements.
+ * Toggles warp mode and updates UI elements. The toggle is posted to the
+ * VICE thread, so toggling warp doesn't stall emulation for the main lock,
+ * and the menu item is updated once the new mode has been applied.
  */
 static void warp_mode_toggle_action(void)
 {
-    vsync_set_warp_mode(!vsync_get_warp_mode());
-    ui_set_check_menu_item_blocked_by_action(ACTION_WARP_MODE_TOGGLE,
-                                             (gboolean)vsync_get_warp_mode());
+    mainlock_post(warp_mode_toggle_cb, NULL);
 }
 
 
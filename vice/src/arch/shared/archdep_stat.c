@@ -62,3 +62,26 @@ int archdep_stat(const char *path, size_t *len, unsigned int *isdir)
     *isdir = S_ISDIR(statbuf.st_mode);
     return 0;
 }
+
+
+/** \brief  Get size and modification time of \a path
+ *
+ * \param[in]   path    pathname
+ * \param[out]  len     length of file \a pathname
+ * \param[out]  mtime   time of last modification
+ *
+ * \return  0 on success, -1 on failure
+ */
+int archdep_stat_mtime(const char *path, size_t *len, time_t *mtime)
+{
+    struct stat statbuf;
+
+    if (stat(path, &statbuf) < 0) {
+        *len = 0;
+        *mtime = 0;
+        return -1;
+    }
+    *len = statbuf.st_size;
+    *mtime = statbuf.st_mtime;
+    return 0;
+}
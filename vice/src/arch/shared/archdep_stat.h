@@ -28,7 +28,9 @@
 #define ARCHDEP_STAT_H
 
 #include <stddef.h>
+#include <time.h>
 
 int archdep_stat(const char *filename, size_t *len, unsigned int *isdir);
+int archdep_stat_mtime(const char *path, size_t *len, time_t *mtime);
 
 #endif
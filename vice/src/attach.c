@@ -427,6 +427,11 @@ static int set_file_system_device(int val, void *param)
         return 0;
     }
 
+    if (old_device_enabled == ATTACH_DEVICE_FS) {
+        /* files still open on the host are closed like on CLOSE */
+        fsdevice_close_all(unit);
+    }
+
     if (old_device_enabled == ATTACH_DEVICE_REAL) {
         DBG(("set_file_system_device: old == ATTACH_DEVICE_REAL, serial_realdevice_disable()"));
         serial_realdevice_disable();
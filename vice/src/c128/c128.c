@@ -818,12 +818,10 @@ int machine_resources_init(void)
         return -1;
     }
 #endif
-#ifdef DEBUG
     if (debug_resources_init() < 0) {
         init_resource_fail("debug");
         return -1;
     }
-#endif
 #ifdef HAVE_MOUSE
 #ifdef HAVE_LIGHTPEN
     if (lightpen_resources_init() < 0) {
@@ -1068,12 +1066,10 @@ int machine_cmdline_options_init(void)
         return -1;
     }
 #endif
-#ifdef DEBUG
     if (debug_cmdline_options_init() < 0) {
         init_cmdline_options_fail("debug");
         return -1;
     }
-#endif
 #ifdef HAVE_MOUSE
     if (mouse_cmdline_options_init() < 0) {
         init_cmdline_options_fail("mouse");
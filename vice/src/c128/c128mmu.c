@@ -467,7 +467,14 @@ void mmu_store(uint16_t address, uint8_t value)
                 break;
         }
 
-        mmu_update_page01_pointers();
+        /* A CR write only affects the page 0/1 pointers if it switches the
+           RAM bank, or if a page has been moved above $3fff where the ROM
+           and I/O bits decide whether it is RAM. Software switching ROMs
+           through $ff00 all the time doesn't need the update. */
+        if ((address != 0) || ((oldvalue ^ value) & 0xc0)
+            || (mmu[7] > 0x3f) || (mmu[9] > 0x3f)) {
+            mmu_update_page01_pointers();
+        }
 
         mmu_update_config();
     }
@@ -83,6 +83,7 @@ int c64_snapshot_write(const char *name, int save_roms, int save_disks, int even
         || vicii_snapshot_write_module(s) < 0
         || c64_glue_snapshot_write_module(s) < 0
         || event_snapshot_write_module(s, event_mode) < 0
+        || machine_common_snapshot_write_module(s) < 0
         || memhacks_snapshot_write_modules(s) < 0
         || tapeport_snapshot_write_module(s, save_disks) < 0
         || keyboard_snapshot_write_module(s) < 0
@@ -128,6 +129,7 @@ int c64_snapshot_read(const char *name, int event_mode)
         || vicii_snapshot_read_module(s) < 0
         || c64_glue_snapshot_read_module(s) < 0
         || event_snapshot_read_module(s, event_mode) < 0
+        || machine_common_snapshot_read_module(s) < 0
         || memhacks_snapshot_read_modules(s) < 0
         || tapeport_snapshot_read_module(s) < 0
         || keyboard_snapshot_read_module(s) < 0
@@ -34,6 +34,7 @@
 #include "c64cart.h"
 #include "c64iec.h"
 #include "cartridge.h"
+#include "debug.h"
 #include "drive.h"
 #include "iecbus.h"
 #include "iecdrive.h"
@@ -147,6 +148,10 @@ void iec_drive_write(uint8_t data, unsigned int dnr)
     iecbus.drv_bus[dnr + 8] = (((data << 3) & 0x40) | ((data << 6) & ((~data ^ iecbus.cpu_bus) << 3) & 0x80));
     iecbus.drv_data[dnr + 8] = data;
     iec_update_ports();
+
+    if (debug.bustrace) {
+        iec_drive_bus_trace(&iecbus, dnr);
+    }
 }
 
 uint8_t iec_drive_read(unsigned int dnr)
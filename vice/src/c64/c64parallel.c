@@ -33,6 +33,7 @@
 #include "c64.h"
 #include "c64parallel.h"
 #include "cia.h"
+#include "debug.h"
 #include "dolphindos3.h"
 #include "drive.h"
 #include "drivetypes.h"
@@ -184,6 +185,11 @@ void parallel_cable_drive_write(int type, uint8_t data, int handshake, unsigned
     if (handshake == PARALLEL_WRITE_HS || handshake == PARALLEL_WRITE) {
         parallel_cable_drive_value[dnr] = data;
     }
+
+    if (debug.bustrace) {
+        debug_bustrace(DEBUG_BUSTRACE_PARALLEL, dnr, DEBUG_BUSTRACE_DRIVE,
+                       data | ((unsigned int)handshake << 8) | ((unsigned int)port << 16));
+    }
 }
 
 uint8_t parallel_cable_drive_read(int type, int handshake)
@@ -237,6 +243,11 @@ void parallel_cable_cpu_write(int type, uint8_t data)
     parallel_cable_cpu_value[port] = data;
 
     DBG(("PARCABLE (%d:%d) CPU W DATA %02x", type, port, data));
+
+    if (debug.bustrace) {
+        debug_bustrace(DEBUG_BUSTRACE_PARALLEL, 0, DEBUG_BUSTRACE_COMPUTER,
+                       data | ((unsigned int)port << 16));
+    }
 }
 
 uint8_t parallel_cable_cpu_read(int type, uint8_t data)
@@ -260,6 +271,12 @@ void parallel_cable_cpu_pulse(int type)
 
     DBG(("PARCABLE (%d:%d) CPU Pulse", type, portmap[type]));
 
+    if (debug.bustrace) {
+        debug_bustrace(DEBUG_BUSTRACE_PARALLEL, 0, DEBUG_BUSTRACE_COMPUTER,
+                       parallel_cable_cpu_value[portmap[type]] | 0x100
+                       | ((unsigned int)portmap[type] << 16));
+    }
+
     for (dnr = 0; dnr < NUM_DISK_UNITS; dnr++) {
         diskunit_context_t *unit = diskunit_context[dnr];
 
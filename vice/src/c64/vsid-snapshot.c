@@ -76,6 +76,7 @@ int c64_snapshot_write(const char *name, int save_roms, int save_disks, int even
         || vicii_snapshot_write_module(s) < 0
         || c64_glue_snapshot_write_module(s) < 0
         || event_snapshot_write_module(s, event_mode) < 0
+        || machine_common_snapshot_write_module(s) < 0
         || keyboard_snapshot_write_module(s)) {
         snapshot_close(s);
         archdep_remove(name);
@@ -112,6 +113,7 @@ int c64_snapshot_read(const char *name, int event_mode)
         || vicii_snapshot_read_module(s) < 0
         || c64_glue_snapshot_read_module(s) < 0
         || event_snapshot_read_module(s, event_mode) < 0
+        || machine_common_snapshot_read_module(s) < 0
         || keyboard_snapshot_read_module(s) < 0) {
         goto fail;
     }
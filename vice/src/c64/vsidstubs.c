@@ -503,6 +503,10 @@ image_contents_t *diskcontents_block_read(struct vdrive_s *vdrive, int part)
     return NULL;
 }
 
+void image_contents_cache_shutdown(void)
+{
+}
+
 /*******************************************************************************
     fileio
 *******************************************************************************/
@@ -566,6 +570,10 @@ int fsdevice_attach(unsigned int device, unsigned int drive, const char *name)
     return 0;
 }
 
+void fsdevice_close_all(unsigned int unit)
+{
+}
+
 void fsdevice_set_directory(char *filename, unsigned int unit)
 {
 }
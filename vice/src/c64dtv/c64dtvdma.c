@@ -75,10 +75,39 @@ static int dest_line_off = 0;
 static uint8_t source_memtype = 0x00;
 static uint8_t dest_memtype = 0x00;
 
+/* shadow register fields, decoded on register write instead of per byte */
+static int reg06_source_step;
+static int reg08_dest_step;
+static int reg0c_source_modulo;
+static int reg0e_dest_modulo;
+static int reg10_source_line_length;
+static int reg12_dest_line_length;
+static int reg1e_source_modulo_enable;
+static int reg1e_dest_modulo_enable;
+static int reg1f_swap;
+static int reg1f_source_direction;
+static int reg1f_dest_direction;
+
 #define GET_REG24(a) ((c64dtvmem_dma[a + 2] << 16) | (c64dtvmem_dma[a + 1] << 8) | c64dtvmem_dma[a])
 #define GET_REG16(a) ((c64dtvmem_dma[a + 1] << 8) | c64dtvmem_dma[a])
 #define GET_REG8(a) (c64dtvmem_dma[a])
 
+/* Decode the registers used while transferring into the shadow fields */
+static void update_shadow_registers(void)
+{
+    reg06_source_step = GET_REG16(0x06);
+    reg08_dest_step = GET_REG16(0x08);
+    reg0c_source_modulo = GET_REG16(0x0c);
+    reg0e_dest_modulo = GET_REG16(0x0e);
+    reg10_source_line_length = GET_REG16(0x10);
+    reg12_dest_line_length = GET_REG16(0x12);
+    reg1e_source_modulo_enable = GET_REG8(0x1e) & 0x01;
+    reg1e_dest_modulo_enable = GET_REG8(0x1e) & 0x02;
+    reg1f_swap = GET_REG8(0x1f) & 0x02;
+    reg1f_source_direction = (GET_REG8(0x1f) & 0x04) ? +1 : -1;
+    reg1f_dest_direction = (GET_REG8(0x1f) & 0x08) ? +1 : -1;
+}
+
 /* ------------------------------------------------------------------------- */
 
 void c64dtvdma_init(void)
@@ -126,6 +155,7 @@ void c64dtvdma_reset(void)
     dma_data = 0x00;
     source_line_off = 0;
     dest_line_off = 0;
+    update_shadow_registers();
 }
 
 /* ------------------------------------------------------------------------- */
@@ -221,38 +251,27 @@ static inline void do_dma_write(int swap)
 
 static inline void update_counters(void)
 {
-    int source_step = GET_REG16(0x06);
-    int dest_step = GET_REG16(0x08);
-    int source_modulo = GET_REG16(0x0c);
-    int dest_modulo = GET_REG16(0x0e);
-    int source_line_length = GET_REG16(0x10);
-    int dest_line_length = GET_REG16(0x12);
-    int source_modulo_enable = GET_REG8(0x1e) & 0x01;
-    int dest_modulo_enable = GET_REG8(0x1e) & 0x02;
-    int source_direction = (GET_REG8(0x1f) & 0x04) ? +1 : -1;
-    int dest_direction = (GET_REG8(0x1f) & 0x08) ? +1 : -1;
-
     /* update offsets */
-    if (source_modulo_enable && (source_line_off >= source_line_length)) {
+    if (reg1e_source_modulo_enable && (source_line_off >= reg10_source_line_length)) {
         source_line_off = 0;
-        dma_source_off += source_modulo * source_direction;
+        dma_source_off += reg0c_source_modulo * reg1f_source_direction;
     } else {
         source_line_off++;
-        dma_source_off += source_step * source_direction;
+        dma_source_off += reg06_source_step * reg1f_source_direction;
     }
 
-    if (dest_modulo_enable && (dest_line_off >= dest_line_length)) {
+    if (reg1e_dest_modulo_enable && (dest_line_off >= reg12_dest_line_length)) {
         dest_line_off = 0;
-        dma_dest_off += dest_modulo * dest_direction;
+        dma_dest_off += reg0e_dest_modulo * reg1f_dest_direction;
     } else {
         dest_line_off++;
-        dma_dest_off += dest_step * dest_direction;
+        dma_dest_off += reg08_dest_step * reg1f_dest_direction;
     }
 }
 
 static inline void perform_dma_cycle(void)
 {
-    int swap = GET_REG8(0x1f) & 0x02;
+    int swap = reg1f_swap;
 
     switch (dma_state) {
         case DMA_IDLE:
@@ -372,6 +391,10 @@ void c64dtv_dma_store(uint16_t addr, uint8_t value)
        requested, perform if necessary. */
     c64dtvmem_dma[addr] = value;
 
+    if (addr >= 0x06) {
+        update_shadow_registers();
+    }
+
     dma_on_irq = GET_REG8(0x1f) & 0x70;
 
     /* Clear DMA IRQ */
@@ -383,6 +406,7 @@ void c64dtv_dma_store(uint16_t addr, uint8_t value)
 #endif
         dma_busy &= 0xfd;
         c64dtvmem_dma[0x1f] = 0;
+        update_shadow_registers();
         maincpu_set_irq(c64dtv_dma_int_num, 0);
         dma_irq = 0;
         /* reset clear IRQ strobe bit */
@@ -584,6 +608,7 @@ int c64dtvdma_snapshot_read_module(snapshot_t *s)
     }
 
     dma_state = temp_dma_state;
+    update_shadow_registers();
 
     return snapshot_module_close(m);
 
@@ -82,6 +82,7 @@ int cbm2_snapshot_write(const char *name, int save_roms, int save_disks,
         || drive_snapshot_write_module(s, save_disks, save_roms) < 0
         || fsdrive_snapshot_write_module(s) < 0
         || event_snapshot_write_module(s, event_mode) < 0
+        || machine_common_snapshot_write_module(s) < 0
         || tapeport_snapshot_write_module(s, save_disks) < 0
         || keyboard_snapshot_write_module(s) < 0
         || userport_snapshot_write_module(s) < 0) {
@@ -122,6 +123,7 @@ int cbm2_snapshot_read(const char *name, int event_mode)
         || drive_snapshot_read_module(s) < 0
         || fsdrive_snapshot_read_module(s) < 0
         || event_snapshot_read_module(s, event_mode) < 0
+        || machine_common_snapshot_read_module(s) < 0
         || tapeport_snapshot_read_module(s) < 0
         || keyboard_snapshot_read_module(s) < 0
         || userport_snapshot_read_module(s) < 0) {
@@ -34,6 +34,7 @@
 #include "cbm2mem.h"
 #include "cbm2memsnapshot.h"
 #include "cbm2rom.h"
+#include "crtc.h"
 #include "log.h"
 #include "machine.h"
 #include "mem.h"
@@ -404,6 +405,7 @@ static int mem_read_rom_snapshot_module(snapshot_t *p)
             mem_chargen_rom[i + 6144] = mem_chargen_rom[i + 4096] ^ 0xff;
         }
     }
+    crtc_chargen_changed();
 
     if (config & 2) {
         SMR_BA(m, mem_rom + 0x1000, 0x1000);
@@ -28,6 +28,7 @@
 
 #include <stdio.h>
 
+#include "crtc.h"
 #include "types.h"
 #include "userport_io_sim.h"
 
@@ -35,3 +36,7 @@
 void userport_io_sim_set_pbx_out_lines(uint8_t val)
 {
 }
+
+void crtc_chargen_changed(void)
+{
+}
@@ -37,6 +37,7 @@
 #include "archdep.h"
 #include "lib.h"
 #include "machine.h"
+#include "maincpu.h"
 #include "util.h"
 
 #include "rtc.h"
@@ -54,11 +55,74 @@ inline static int bcd_to_int(int bcd)
 
 /* ---------------------------------------------------------------------- */
 
+/* In deterministic mode the clocks start at 2000-01-01 00:00:00 UTC when the
+   emulation starts, advance with the emulated CPU clock, and are converted
+   as UTC instead of host local time.  */
+#define RTC_DETERMINISTIC_EPOCH 946684800
+
+/* days since 1970-01-01 of a proleptic gregorian date, month 1 - 12 */
+static long rtc_days_from_civil(long y, long m, long d)
+{
+    long era, yoe, doy, doe;
+
+    y -= m <= 2;
+    era = (y >= 0 ? y : y - 399) / 400;
+    yoe = y - era * 400;
+    doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static time_t rtc_time_now(void)
+{
+    if (machine_is_deterministic()) {
+        return (time_t)(RTC_DETERMINISTIC_EPOCH
+                        + maincpu_clk / (CLOCK)machine_get_cycles_per_second());
+    }
+    return time(NULL);
+}
+
+static struct tm *rtc_localtime(const time_t *time_val)
+{
+    if (machine_is_deterministic()) {
+        return gmtime(time_val);
+    }
+    return localtime(time_val);
+}
+
+/* inverse of rtc_localtime(), like mktime() this accepts out of range
+   fields (but does not normalize them) */
+static time_t rtc_mktime(struct tm *tm)
+{
+    long year, month;
+
+    if (!machine_is_deterministic()) {
+        return mktime(tm);
+    }
+
+    year = tm->tm_year + 1900L + tm->tm_mon / 12;
+    month = tm->tm_mon % 12;
+    if (month < 0) {
+        month += 12;
+        year--;
+    }
+    return (time_t)(rtc_days_from_civil(year, month + 1, 1) + tm->tm_mday - 1) * 86400
+           + tm->tm_hour * 3600L + tm->tm_min * 60L + tm->tm_sec;
+}
+
 /* get 1/100 seconds from clock */
 uint8_t rtc_get_centisecond(int bcd)
 {
-    return (uint8_t)((bcd) ? (uint8_t)int_to_bcd(archdep_rtc_get_centisecond())
-                           : archdep_rtc_get_centisecond());
+    int centisecond;
+
+    if (machine_is_deterministic()) {
+        CLOCK cycles = (CLOCK)machine_get_cycles_per_second();
+
+        centisecond = (int)((maincpu_clk % cycles) * 100 / cycles);
+    } else {
+        centisecond = archdep_rtc_get_centisecond();
+    }
+    return (uint8_t)((bcd) ? (uint8_t)int_to_bcd(centisecond) : centisecond);
 }
 
 /* get seconds from time value
@@ -66,7 +130,7 @@ uint8_t rtc_get_centisecond(int bcd)
 uint8_t rtc_get_second(time_t time_val, int bcd)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint8_t)((bcd) ? int_to_bcd(local->tm_sec) : local->tm_sec);
 }
@@ -76,7 +140,7 @@ uint8_t rtc_get_second(time_t time_val, int bcd)
 uint8_t rtc_get_minute(time_t time_val, int bcd)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint8_t)((bcd) ? int_to_bcd(local->tm_min) : local->tm_min);
 }
@@ -86,7 +150,7 @@ uint8_t rtc_get_minute(time_t time_val, int bcd)
 uint8_t rtc_get_hour(time_t time_val, int bcd)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint8_t)((bcd) ? int_to_bcd(local->tm_hour) : local->tm_hour);
 }
@@ -98,7 +162,7 @@ uint8_t rtc_get_hour_am_pm(time_t time_val, int bcd)
     uint8_t hour;
     int pm = 0;
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     hour = local->tm_hour;
 
@@ -120,7 +184,7 @@ uint8_t rtc_get_hour_am_pm(time_t time_val, int bcd)
 uint8_t rtc_get_day_of_month(time_t time_val, int bcd)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint8_t)((bcd) ? int_to_bcd(local->tm_mday) : local->tm_mday);
 }
@@ -130,7 +194,7 @@ uint8_t rtc_get_day_of_month(time_t time_val, int bcd)
 uint8_t rtc_get_month(time_t time_val, int bcd)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint8_t)((bcd) ? int_to_bcd(local->tm_mon + 1) : (local->tm_mon + 1));
 }
@@ -140,7 +204,7 @@ uint8_t rtc_get_month(time_t time_val, int bcd)
 uint8_t rtc_get_year(time_t time_val, int bcd)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint8_t)((bcd) ? int_to_bcd(local->tm_year % 100) : local->tm_year % 100);
 }
@@ -150,7 +214,7 @@ uint8_t rtc_get_year(time_t time_val, int bcd)
 uint8_t rtc_get_century(time_t time_val, int bcd)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint8_t)((bcd) ? int_to_bcd((int)(local->tm_year / 100) + 19) : (int)(local->tm_year / 100) + 19);
 }
@@ -160,7 +224,7 @@ uint8_t rtc_get_century(time_t time_val, int bcd)
 uint8_t rtc_get_weekday(time_t time_val)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint8_t)local->tm_wday;
 }
@@ -170,7 +234,7 @@ uint8_t rtc_get_weekday(time_t time_val)
 uint16_t rtc_get_day_of_year(time_t time_val)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return (uint16_t)local->tm_yday;
 }
@@ -180,7 +244,7 @@ uint16_t rtc_get_day_of_year(time_t time_val)
 int rtc_get_dst(time_t time_val)
 {
     time_t now = time_val;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     return local->tm_isdst;
 }
@@ -188,7 +252,7 @@ int rtc_get_dst(time_t time_val)
 /* get the current clock based on time + offset so the value can be latched */
 time_t rtc_get_latch(time_t offset)
 {
-    return time(NULL) + offset;
+    return rtc_time_now() + offset;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -197,8 +261,8 @@ time_t rtc_get_latch(time_t offset)
    0 - 59 */
 time_t rtc_set_second(int seconds, time_t offset, int bcd)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_seconds = (bcd) ? bcd_to_int(seconds) : seconds;
 
@@ -207,7 +271,7 @@ time_t rtc_set_second(int seconds, time_t offset, int bcd)
         return offset;
     }
     local->tm_sec = real_seconds;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset + (offset_now - now);
 }
@@ -216,8 +280,8 @@ time_t rtc_set_second(int seconds, time_t offset, int bcd)
    0 - 59 */
 time_t rtc_set_minute(int minutes, time_t offset, int bcd)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_minutes = (bcd) ? bcd_to_int(minutes) : minutes;
 
@@ -226,7 +290,7 @@ time_t rtc_set_minute(int minutes, time_t offset, int bcd)
         return offset;
     }
     local->tm_min = real_minutes;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset + (offset_now - now);
 }
@@ -235,8 +299,8 @@ time_t rtc_set_minute(int minutes, time_t offset, int bcd)
    0 - 23 */
 time_t rtc_set_hour(int hours, time_t offset, int bcd)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_hours = (bcd) ? bcd_to_int(hours) : hours;
 
@@ -245,7 +309,7 @@ time_t rtc_set_hour(int hours, time_t offset, int bcd)
         return offset;
     }
     local->tm_hour = real_hours;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset + (offset_now - now);
 }
@@ -254,8 +318,8 @@ time_t rtc_set_hour(int hours, time_t offset, int bcd)
    1 - 12 and AM/PM indicator */
 time_t rtc_set_hour_am_pm(int hours, time_t offset, int bcd)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_hours = (bcd) ? bcd_to_int(hours & 0x1f) : hours & 0x1f;
     int pm = (hours & 0x20) >> 5;
@@ -272,7 +336,7 @@ time_t rtc_set_hour_am_pm(int hours, time_t offset, int bcd)
         return offset;
     }
     local->tm_hour = real_hours;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset + (offset_now - now);
 }
@@ -281,8 +345,8 @@ time_t rtc_set_hour_am_pm(int hours, time_t offset, int bcd)
    1 - 31 */
 time_t rtc_set_day_of_month(int day, time_t offset, int bcd)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int is_leap_year = 0;
     int year = local->tm_year + 1900;
@@ -322,7 +386,7 @@ time_t rtc_set_day_of_month(int day, time_t offset, int bcd)
             break;
     }
     local->tm_mday = real_day;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset + (offset_now - now);
 }
@@ -331,8 +395,8 @@ time_t rtc_set_day_of_month(int day, time_t offset, int bcd)
    1 - 12 */
 time_t rtc_set_month(int month, time_t offset, int bcd)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_month = (bcd) ? bcd_to_int(month) : month;
 
@@ -341,7 +405,7 @@ time_t rtc_set_month(int month, time_t offset, int bcd)
         return offset;
     }
     local->tm_mon = real_month - 1;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset + (offset_now - now);
 }
@@ -350,8 +414,8 @@ time_t rtc_set_month(int month, time_t offset, int bcd)
    0 - 99 */
 time_t rtc_set_year(int year, time_t offset, int bcd)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_year = (bcd) ? bcd_to_int(year) : year;
 
@@ -361,7 +425,7 @@ time_t rtc_set_year(int year, time_t offset, int bcd)
     }
     local->tm_year = (local->tm_year / 100) * 100;
     local->tm_year += real_year;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset + (offset_now - now);
 }
@@ -370,8 +434,8 @@ time_t rtc_set_year(int year, time_t offset, int bcd)
    19 - 20 */
 time_t rtc_set_century(int century, time_t offset, int bcd)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_century = (bcd) ? bcd_to_int(century) : century;
 
@@ -381,7 +445,7 @@ time_t rtc_set_century(int century, time_t offset, int bcd)
     }
     local->tm_year %= 100;
     local->tm_year += ((real_century - 19) * 100);
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset + (offset_now - now);
 }
@@ -390,8 +454,8 @@ time_t rtc_set_century(int century, time_t offset, int bcd)
    0 - 6 */
 time_t rtc_set_weekday(int day, time_t offset)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
 
     /* sanity check */
     if (day < 0 || day > 6) {
@@ -404,8 +468,8 @@ time_t rtc_set_weekday(int day, time_t offset)
    0 - 365 */
 time_t rtc_set_day_of_year(int day, time_t offset)
 {
-    time_t now = time(NULL) + offset;
-    struct tm *local = localtime(&now);
+    time_t now = rtc_time_now() + offset;
+    struct tm *local = rtc_localtime(&now);
     int is_leap_year = 0;
     int year = local->tm_year + 1900;
 
@@ -431,7 +495,7 @@ time_t rtc_set_day_of_year(int day, time_t offset)
 time_t rtc_set_latched_second(int seconds, time_t latch, int bcd)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_seconds = (bcd) ? bcd_to_int(seconds) : seconds;
 
@@ -440,7 +504,7 @@ time_t rtc_set_latched_second(int seconds, time_t latch, int bcd)
         return latch;
     }
     local->tm_sec = real_seconds;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset_now;
 }
@@ -450,7 +514,7 @@ time_t rtc_set_latched_second(int seconds, time_t latch, int bcd)
 time_t rtc_set_latched_minute(int minutes, time_t latch, int bcd)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_minutes = (bcd) ? bcd_to_int(minutes) : minutes;
 
@@ -459,7 +523,7 @@ time_t rtc_set_latched_minute(int minutes, time_t latch, int bcd)
         return latch;
     }
     local->tm_min = real_minutes;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset_now;
 }
@@ -469,7 +533,7 @@ time_t rtc_set_latched_minute(int minutes, time_t latch, int bcd)
 time_t rtc_set_latched_hour(int hours, time_t latch, int bcd)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_hours = (bcd) ? bcd_to_int(hours) : hours;
 
@@ -478,7 +542,7 @@ time_t rtc_set_latched_hour(int hours, time_t latch, int bcd)
         return latch;
     }
     local->tm_hour = real_hours;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset_now;
 }
@@ -488,7 +552,7 @@ time_t rtc_set_latched_hour(int hours, time_t latch, int bcd)
 time_t rtc_set_latched_hour_am_pm(int hours, time_t latch, int bcd)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_hours = (bcd) ? bcd_to_int(hours & 0x1f) : hours & 0x1f;
     int pm = (hours & 0x20) >> 5;
@@ -505,7 +569,7 @@ time_t rtc_set_latched_hour_am_pm(int hours, time_t latch, int bcd)
         return latch;
     }
     local->tm_hour = real_hours;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset_now;
 }
@@ -515,7 +579,7 @@ time_t rtc_set_latched_hour_am_pm(int hours, time_t latch, int bcd)
 time_t rtc_set_latched_day_of_month(int day, time_t latch, int bcd)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int is_leap_year = 0;
     int year = local->tm_year + 1900;
@@ -555,7 +619,7 @@ time_t rtc_set_latched_day_of_month(int day, time_t latch, int bcd)
             break;
     }
     local->tm_mday = real_day;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset_now;
 }
@@ -565,7 +629,7 @@ time_t rtc_set_latched_day_of_month(int day, time_t latch, int bcd)
 time_t rtc_set_latched_month(int month, time_t latch, int bcd)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_month = (bcd) ? bcd_to_int(month) : month;
 
@@ -574,7 +638,7 @@ time_t rtc_set_latched_month(int month, time_t latch, int bcd)
         return latch;
     }
     local->tm_mon = real_month - 1;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset_now;
 }
@@ -584,7 +648,7 @@ time_t rtc_set_latched_month(int month, time_t latch, int bcd)
 time_t rtc_set_latched_year(int year, time_t latch, int bcd)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_year = (bcd) ? bcd_to_int(year) : year;
 
@@ -594,7 +658,7 @@ time_t rtc_set_latched_year(int year, time_t latch, int bcd)
     }
     local->tm_year = (local->tm_year / 100) * 100;
     local->tm_year += real_year;
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset_now;
 }
@@ -604,7 +668,7 @@ time_t rtc_set_latched_year(int year, time_t latch, int bcd)
 time_t rtc_set_latched_century(int century, time_t latch, int bcd)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     time_t offset_now;
     int real_century = (bcd) ? bcd_to_int(century) : century;
 
@@ -614,7 +678,7 @@ time_t rtc_set_latched_century(int century, time_t latch, int bcd)
     }
     local->tm_year %= 100;
     local->tm_year += ((real_century - 19) * 100);
-    offset_now = mktime(local);
+    offset_now = rtc_mktime(local);
 
     return offset_now;
 }
@@ -624,7 +688,7 @@ time_t rtc_set_latched_century(int century, time_t latch, int bcd)
 time_t rtc_set_latched_weekday(int day, time_t latch)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
 
     /* sanity check */
     if (day < 0 || day > 6) {
@@ -638,7 +702,7 @@ time_t rtc_set_latched_weekday(int day, time_t latch)
 time_t rtc_set_latched_day_of_year(int day, time_t latch)
 {
     time_t now = latch;
-    struct tm *local = localtime(&now);
+    struct tm *local = rtc_localtime(&now);
     int is_leap_year = 0;
     int year = local->tm_year + 1900;
 
@@ -822,6 +886,11 @@ void rtc_save_context(uint8_t *ram, int ram_size, uint8_t *regs, int reg_size, c
     int i;
     char *savedir;
 
+    /* keep the saved clocks out of (and untouched by) deterministic runs */
+    if (machine_is_deterministic()) {
+        return;
+    }
+
     filename = archdep_default_rtc_file_name();
 
     /* create the directory where the context should be written first */
@@ -875,7 +944,7 @@ static time_t loaded_offset = 0;
 int rtc_load_context(char *device, int ram_size, int reg_size)
 {
     FILE *infile = NULL;
-    char *filename = archdep_default_rtc_file_name();
+    char *filename;
     char *indata = NULL;
     off_t len;
     int ok = 0;
@@ -887,6 +956,12 @@ int rtc_load_context(char *device, int ram_size, int reg_size)
     loaded_regs = NULL;
     loaded_offset = 0;
 
+    if (machine_is_deterministic()) {
+        return 0;
+    }
+
+    filename = archdep_default_rtc_file_name();
+
     if (util_file_exists(filename)) {
         infile = fopen(filename, "rb");
         if (infile) {
@@ -33,6 +33,7 @@
 #include "crtc-draw.h"
 #include "crtc.h"
 #include "crtctypes.h"
+#include "lib.h"
 #include "raster-modes.h"
 #include "types.h"
 
@@ -48,6 +49,13 @@
  */
 uint32_t dwg_table[16];
 
+/*
+ * Bit expansion table: expands a whole byte to 8 bytes, one pixel per
+ * byte, so a character line is expanded with a single table lookup.
+ * The msb of the input is mapped to the lowest-address byte.
+ */
+static uint8_t dwg_table8[256][8];
+
 static void init_drawing_tables(void)
 {
     int byte, p;
@@ -59,8 +67,105 @@ static void init_drawing_tables(void)
                 = (byte & msk ? 1 : 0);
         }
     }
+
+    for (byte = 0; byte < 0x100; byte++) {
+        for (msk = 0x80, p = 0; p < 8; msk >>= 1, p++) {
+            dwg_table8[byte][p] = (byte & msk ? 1 : 0);
+        }
+    }
+}
+
+/***************************************************************************/
+
+/*
+ * Line cache.
+ *
+ * Business software mostly shows static text screens, so most rasterlines
+ * look exactly like they did in the previous frame.  For every part of a
+ * rasterline drawn by DRAW() we remember what it was drawn from (screen
+ * memory contents, charset line, cursor position and the CRTC timing
+ * values) together with the resulting pixels.  If nothing changed, the
+ * pixels are copied from the cache instead of expanding each character
+ * again.
+ *
+ * The charset itself is not compared; code that changes the charset
+ * memory behind our back must call crtc_chargen_changed(), which drops
+ * the cache.
+ */
+
+/* Maximum number of characters a cached line part may have.  */
+#define CRTC_DRAW_CACHE_MAX_COLS    0x100
+
+/* Each rasterline has two parts, see draw_standard_line().  */
+#define CRTC_DRAW_CACHE_PARTS       2
+
+typedef struct crtc_draw_cache_s {
+    int valid;
+
+    int reverse_flag;
+    int offset;
+    int scr_rel;
+    int xs, xc, xe;
+    int crsr_pos;               /* column of the cursor, -1 if none */
+    uint8_t *chargen_ptr;
+    uint8_t *screen_ptr;
+
+    uint8_t screen_data[CRTC_DRAW_CACHE_MAX_COLS];
+    uint8_t pixels[CRTC_DRAW_CACHE_MAX_COLS * 8];
+} crtc_draw_cache_t;
+
+static crtc_draw_cache_t **draw_cache = NULL;
+static unsigned int draw_cache_lines = 0;
+
+void crtc_draw_cache_invalidate(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < draw_cache_lines * CRTC_DRAW_CACHE_PARTS; i++) {
+        if (draw_cache[i] != NULL) {
+            draw_cache[i]->valid = 0;
+        }
+    }
+}
+
+static crtc_draw_cache_t *draw_cache_get(int part)
+{
+    unsigned int line = crtc.raster.current_line;
+    unsigned int idx;
+
+    if (line >= draw_cache_lines) {
+        unsigned int i, lines = line + 1;
+
+        if (lines < crtc.screen_height) {
+            lines = crtc.screen_height;
+        }
+        draw_cache = lib_realloc(draw_cache, lines * CRTC_DRAW_CACHE_PARTS
+                                             * sizeof(crtc_draw_cache_t *));
+        for (i = draw_cache_lines * CRTC_DRAW_CACHE_PARTS;
+             i < lines * CRTC_DRAW_CACHE_PARTS; i++) {
+            draw_cache[i] = NULL;
+        }
+        draw_cache_lines = lines;
+    }
+
+    idx = line * CRTC_DRAW_CACHE_PARTS + part;
+    if (draw_cache[idx] == NULL) {
+        draw_cache[idx] = lib_calloc(1, sizeof(crtc_draw_cache_t));
+    }
+    return draw_cache[idx];
 }
 
+static void draw_cache_shutdown(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < draw_cache_lines * CRTC_DRAW_CACHE_PARTS; i++) {
+        lib_free(draw_cache[i]);
+    }
+    lib_free(draw_cache);
+    draw_cache = NULL;
+    draw_cache_lines = 0;
+}
 
 /***************************************************************************/
 
@@ -74,17 +179,41 @@ static void draw_standard_background(unsigned int start_pixel,
 
 /***************************************************************************/
 
+/* expand characters xs..xc-1 of a line part into `pw' */
+static inline void draw_chars(uint8_t *pw, int reverse_flag,
+                              const uint8_t *chargen_ptr,
+                              const uint8_t *screen_ptr, int screen_rel,
+                              int crsr_pos, int xs, int xc)
+{
+    int i;
+    uint8_t d, rev = reverse_flag ? 0xff : 0;
+
+    for (i = xs; i < xc; i++) {
+        /* we use 16 bytes/char character generator */
+        d = *(chargen_ptr
+              + (screen_ptr[screen_rel & crtc.vaddr_mask] << 4)) ^ rev;
+        screen_rel++;
+
+        if (i == crsr_pos) {
+            d ^= 0xff;
+        }
+
+        memcpy(pw, dwg_table8[d], 8);
+        pw += 8;
+    }
+}
+
 /* inline function... */
-static inline void DRAW(int reverse_flag, int offset, int scr_rel,
+static inline void DRAW(int part, int reverse_flag, int offset, int scr_rel,
                         int xs, int xc, int xe)
 {
     /* FIXME: `p' has to be aligned on a 4 byte boundary!
               Is there a better way than masking `offset'?  */
     uint8_t *p = crtc.raster.draw_buffer_ptr + (offset & ~3);
-    uint32_t *pw = (uint32_t *)p;
     uint8_t *chargen_ptr, *screen_ptr;
-    int screen_rel;
-    int i, d;
+    crtc_draw_cache_t *cache;
+    int screen_rel, crsr_pos = -1;
+
     /* pointer to current chargen line */
     chargen_ptr = crtc.chargen_base
                   + crtc.chargen_rel
@@ -93,47 +222,64 @@ static inline void DRAW(int reverse_flag, int offset, int scr_rel,
     screen_ptr = crtc.screen_base;
     screen_rel = ((scr_rel) + (xs));
 
+    if (xc < xs) {
+        xc = xs;
+    }
+    if (xe < xc) {
+        xe = xc;
+    }
+
     if (crtc.crsrmode && crtc.cursor_lines && crtc.crsrstate) {
         int crsrrel = ((crtc.regs[14] << 8) | crtc.regs[15]) & crtc.vaddr_mask;
 
-        for (i = (xs); i < (xc); i++) {
-            d = *(chargen_ptr
-                  + (screen_ptr[screen_rel & crtc.vaddr_mask] << 4));
-
-            /* FIXME: mask with 0x3fff (screen_rel must be expanded) */
-            if (screen_rel == crsrrel) {
-                d ^= 0xff;
-            }
-
-            screen_rel++;
-
-            if ((reverse_flag)) {
-                d ^= 0xff;
-            }
-
-            *pw++ = dwg_table[d >> 4];
-            *pw++ = dwg_table[d & 0x0f];
+        /* FIXME: mask with 0x3fff (screen_rel must be expanded) */
+        if (crsrrel >= screen_rel && crsrrel < screen_rel + (xc - xs)) {
+            crsr_pos = xs + (crsrrel - screen_rel);
         }
+    }
+
+    if (xe - xs > CRTC_DRAW_CACHE_MAX_COLS
+        || (screen_rel & crtc.vaddr_mask) + (xc - xs) > crtc.vaddr_mask + 1) {
+        /* too wide, or wrapping around in screen memory: no caching */
+        draw_chars(p, reverse_flag, chargen_ptr, screen_ptr, screen_rel,
+                   crsr_pos, xs, xc);
+        memset(p + (xc - xs) * 8, 0, (xe - xc) * 8);
     } else {
-        for (i = (xs); i < (xc); i++) {
-            /* we use 16 bytes/char character generator */
-            d = *(chargen_ptr
-                  + (screen_ptr[screen_rel & crtc.vaddr_mask] << 4));
-            screen_rel++;
-
-            if ((reverse_flag)) {
-                d ^= 0xff;
-            }
-
-            *pw++ = dwg_table[d >> 4];
-            *pw++ = dwg_table[d & 0x0f];
+        const uint8_t *screen_data = screen_ptr
+                                     + (screen_rel & crtc.vaddr_mask);
+
+        cache = draw_cache_get(part);
+
+        if (!cache->valid
+            || cache->reverse_flag != reverse_flag
+            || cache->offset != offset
+            || cache->scr_rel != scr_rel
+            || cache->xs != xs
+            || cache->xc != xc
+            || cache->xe != xe
+            || cache->crsr_pos != crsr_pos
+            || cache->chargen_ptr != chargen_ptr
+            || cache->screen_ptr != screen_ptr
+            || memcmp(cache->screen_data, screen_data, xc - xs) != 0) {
+            cache->valid = 1;
+            cache->reverse_flag = reverse_flag;
+            cache->offset = offset;
+            cache->scr_rel = scr_rel;
+            cache->xs = xs;
+            cache->xc = xc;
+            cache->xe = xe;
+            cache->crsr_pos = crsr_pos;
+            cache->chargen_ptr = chargen_ptr;
+            cache->screen_ptr = screen_ptr;
+            memcpy(cache->screen_data, screen_data, xc - xs);
+
+            draw_chars(cache->pixels, reverse_flag, chargen_ptr, screen_ptr,
+                       screen_rel, crsr_pos, xs, xc);
+            /* blank the rest */
+            memset(cache->pixels + (xc - xs) * 8, 0, (xe - xc) * 8);
         }
-    }
 
-    /* blank the rest */
-    for (; i < (xe); i++) {
-        *pw++ = 0;
-        *pw++ = 0;
+        memcpy(p, cache->pixels, (xe - xs) * 8);
     }
 
     if (crtc.hires_draw_callback) {
@@ -153,7 +299,7 @@ static void draw_standard_line(void)
     /* FIXME: check the ends against the maximum line length */
     /* the first part is left of rl_pos. Data is taken from prev. rl */
     if (rl_pos > 8) {
-        DRAW(0,
+        DRAW(0, 0,
              rl_pos % 8,
              crtc.prev_screen_rel,
              (crtc.prev_rl_len + 1) * crtc.hw_cols - (rl_pos / 8),
@@ -162,7 +308,7 @@ static void draw_standard_line(void)
     }
 
     /* this is the "normal" part of the rasterline */
-    DRAW(0,
+    DRAW(1, 0,
          rl_pos,
          crtc.screen_rel,
          0,
@@ -176,7 +322,7 @@ static void draw_reverse_line(void)
 
     /* the first part is left of rl_pos. Data is taken from prev. rl */
     if (rl_pos > 8) {
-        DRAW(1,
+        DRAW(0, 1,
              rl_pos % 8,
              crtc.prev_screen_rel,
              (crtc.prev_rl_len + 1) * crtc.hw_cols - (rl_pos / 8),
@@ -185,7 +331,7 @@ static void draw_reverse_line(void)
     }
 
     /* this is the "normal" part of the rasterline */
-    DRAW(1,
+    DRAW(1, 1,
          rl_pos,
          crtc.screen_rel,
          0,
@@ -249,3 +395,8 @@ void crtc_draw_init(void)
 
     setup_modes();
 }
+
+void crtc_draw_shutdown(void)
+{
+    draw_cache_shutdown();
+}
@@ -35,6 +35,8 @@
 #include "types.h"
 
 extern void crtc_draw_init(void);
+extern void crtc_draw_shutdown(void);
+extern void crtc_draw_cache_invalidate(void);
 
 extern uint32_t dwg_table[16];
 
@@ -419,6 +419,13 @@ void crtc_set_chargen_addr(uint8_t *chargen, int cmask)
     crtc.chargen_mask = (cmask << 4) - 1;
 
     crtc_update_chargen_rel();
+    crtc_draw_cache_invalidate();
+}
+
+/* to be called when the contents of the charset memory have been changed */
+void crtc_chargen_changed(void)
+{
+    crtc_draw_cache_invalidate();
 }
 
 void crtc_set_screen_options(int num_cols, int rasterlines)
@@ -867,6 +874,7 @@ static void crtc_raster_draw_alarm_handler(CLOCK offset, void *data)
 
 void crtc_shutdown(void)
 {
+    crtc_draw_shutdown();
     raster_shutdown(&crtc.raster);
 }
 
@@ -56,6 +56,7 @@ extern int crtc_snapshot_read_module(struct snapshot_s *s);
 extern void crtc_set_screen_addr(uint8_t *screen);
 extern void crtc_set_chargen_offset(int offset);
 extern void crtc_set_chargen_addr(uint8_t *chargen, int cmask);
+extern void crtc_chargen_changed(void);
 extern void crtc_set_screen_options(int num_cols, int rasterlines);
 extern void crtc_set_hw_options(int hwflag, int vmask, int vchar, int vcoffset,
                                 int vrevmask);
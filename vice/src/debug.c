@@ -36,6 +36,7 @@
 #include "interrupt.h"
 #include "lib.h"
 #include "log.h"
+#include "maincpu.h"
 #include "resources.h"
 #include "types.h"
 #include "uiapi.h"
@@ -116,6 +117,113 @@ static int set_autoplay_frames(int val, void *param)
 
 #endif
 
+/* Bus trace.  The file starts with a 16 byte header ("VICEBUSTRACE", format
+   version, record size, two reserved bytes), followed by fixed size little
+   endian records:
+
+   0-7   main CPU clock
+   8     bus (DEBUG_BUSTRACE_*)
+   9     unit (0 for the computer side of the IEC bus, the device number
+         (8-11) for the drive side, drive number for parallel cable and TCBM)
+   10    side (DEBUG_BUSTRACE_COMPUTER or DEBUG_BUSTRACE_DRIVE)
+   11    reserved
+   12-15 line states, depending on the bus
+
+   Records are collected in a buffer that is written out when it is full, so
+   the trace is cheap enough to leave enabled.  */
+
+#define BUSTRACE_VERSION        1
+#define BUSTRACE_RECORD_SIZE    16
+#define BUSTRACE_BUFFER_RECORDS 4096
+
+static char *bustrace_file_name = NULL;
+static FILE *bustrace_fd = NULL;
+static uint8_t *bustrace_buffer = NULL;
+static unsigned int bustrace_records = 0;
+
+static void bustrace_flush(void)
+{
+    if (bustrace_records > 0) {
+        if (fwrite(bustrace_buffer, BUSTRACE_RECORD_SIZE, bustrace_records,
+                   bustrace_fd) != bustrace_records) {
+            log_error(LOG_DEFAULT, "Error writing bus trace file `%s'.",
+                      bustrace_file_name);
+        }
+        bustrace_records = 0;
+    }
+}
+
+static void bustrace_close(void)
+{
+    debug.bustrace = 0;
+
+    if (bustrace_fd != NULL) {
+        bustrace_flush();
+        fclose(bustrace_fd);
+        bustrace_fd = NULL;
+    }
+    lib_free(bustrace_buffer);
+    bustrace_buffer = NULL;
+}
+
+/* only set from the command line, a saved file name would make every
+   later start overwrite the trace */
+static int bustrace_opt(const char *val, void *param)
+{
+    uint8_t header[16] = "VICEBUSTRACE";
+
+    if (util_string_set(&bustrace_file_name, val) < 0) {
+        return 0;
+    }
+
+    bustrace_close();
+
+    if (bustrace_file_name == NULL || *bustrace_file_name == '\0') {
+        return 0;
+    }
+
+    bustrace_fd = fopen(bustrace_file_name, MODE_WRITE);
+    if (bustrace_fd == NULL) {
+        log_error(LOG_DEFAULT, "Cannot open bus trace file `%s'.",
+                  bustrace_file_name);
+        return -1;
+    }
+
+    header[12] = BUSTRACE_VERSION;
+    header[13] = BUSTRACE_RECORD_SIZE;
+    if (fwrite(header, 1, sizeof(header), bustrace_fd) != sizeof(header)
+        || fflush(bustrace_fd) != 0) {
+        log_error(LOG_DEFAULT, "Cannot write bus trace file `%s'.",
+                  bustrace_file_name);
+        fclose(bustrace_fd);
+        bustrace_fd = NULL;
+        return -1;
+    }
+
+    bustrace_buffer = lib_malloc(BUSTRACE_RECORD_SIZE * BUSTRACE_BUFFER_RECORDS);
+    debug.bustrace = 1;
+
+    return 0;
+}
+
+/* Record a bus state, only call this if debug.bustrace is set.  */
+void debug_bustrace(unsigned int bus, unsigned int unit, unsigned int side, uint32_t state)
+{
+    uint8_t *record = bustrace_buffer + bustrace_records * BUSTRACE_RECORD_SIZE;
+
+    util_dword_to_le_buf(record, (uint32_t)maincpu_clk);
+    util_dword_to_le_buf(record + 4, (uint32_t)(maincpu_clk >> 32));
+    record[8] = (uint8_t)bus;
+    record[9] = (uint8_t)unit;
+    record[10] = (uint8_t)side;
+    record[11] = 0;
+    util_dword_to_le_buf(record + 12, state);
+
+    if (++bustrace_records == BUSTRACE_BUFFER_RECORDS) {
+        bustrace_flush();
+    }
+}
+
 /* Debug-related resources. */
 static const resource_int_t resources_int[] = {
     { "DoCoreDump", 0, RES_EVENT_NO, NULL,
@@ -150,6 +258,9 @@ int debug_resources_init(void)
 
 static const cmdline_option_t cmdline_options[] =
 {
+    { "-bustrace", CALL_FUNCTION, CMDLINE_ATTRIB_NEED_ARGS,
+      bustrace_opt, NULL, NULL, NULL,
+      "<Name>", "Record IEC, parallel cable and TCBM bus activity to a binary trace file" },
 #ifdef DEBUG
     { "-trace_maincpu", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
       NULL, NULL, "MainCPU_TRACE", (resource_value_t)1,
@@ -217,6 +328,13 @@ void debug_set_machine_parameter(unsigned int cycles, unsigned int lines)
     screen_lines = lines;
 }
 
+void debug_shutdown(void)
+{
+    bustrace_close();
+    lib_free(bustrace_file_name);
+    bustrace_file_name = NULL;
+}
+
 #ifdef DEBUG
 #define RLINE(clk)  ((unsigned int)((clk) / cycles_per_line % screen_lines))
 #define RCYCLE(clk) ((unsigned int)((clk) % cycles_per_line))
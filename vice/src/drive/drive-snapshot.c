@@ -807,8 +807,35 @@ static int drive_snapshot_read_image_module(snapshot_t *s, unsigned int dnr)
 /* -------------------------------------------------------------------- */
 /* read/write GCR disk image snapshot module */
 
+/*
+ * Each half track is saved as:
+ *
+ * DWORD size           size of the half track, 0 if it is not present
+ * BYTE  encoding       (since 3.2) GCR_TRACK_RAW or GCR_TRACK_FILL
+ * BYTE  data[size]     GCR_TRACK_RAW: the track data
+ * BYTE  fill           GCR_TRACK_FILL: the value all bytes of the track have
+ *
+ * Unformatted tracks and the empty odd half tracks created for D64/D71
+ * images are a single value repeated, which makes up about half of the
+ * data of a typical image.
+ */
+
 #define GCRIMAGE_SNAP_MAJOR 3
-#define GCRIMAGE_SNAP_MINOR 1
+#define GCRIMAGE_SNAP_MINOR 2
+
+/* 3.1 is the oldest version that can be read, 3.2 added the encoding byte */
+#define GCRIMAGE_SNAP_MINOR_MIN      1
+#define GCRIMAGE_SNAP_MINOR_ENCODING 2
+
+#define GCR_TRACK_RAW   0
+#define GCR_TRACK_FILL  1
+
+/* Return nonzero if all `size' bytes of `data' are the same.  */
+static int gcr_track_is_filled(const uint8_t *data, uint32_t size)
+{
+    return size > 0 && data[0] == data[size - 1]
+           && memcmp(data, data + 1, size - 1) == 0;
+}
 
 static int drive_snapshot_write_gcrimage_module(snapshot_t *s, unsigned int dnr)
 {
@@ -840,12 +867,25 @@ static int drive_snapshot_write_gcrimage_module(snapshot_t *s, unsigned int dnr)
     for (i = 0; i < num_half_tracks; i++) {
         data = drive->gcr->tracks[i].data;
         track_size = data ? drive->gcr->tracks[i].size : 0;
-        if (0
-            || SMW_DW(m, (uint32_t)track_size) < 0
-            || (track_size && SMW_BA(m, data, track_size) < 0)
-            ) {
+        if (SMW_DW(m, (uint32_t)track_size) < 0) {
             break;
         }
+        if (track_size == 0) {
+            continue;
+        }
+        if (gcr_track_is_filled(data, track_size)) {
+            if (0
+                || SMW_B(m, GCR_TRACK_FILL) < 0
+                || SMW_B(m, data[0]) < 0) {
+                break;
+            }
+        } else {
+            if (0
+                || SMW_B(m, GCR_TRACK_RAW) < 0
+                || SMW_BA(m, data, track_size) < 0) {
+                break;
+            }
+        }
     }
 
     if (snapshot_module_close(m) < 0 || (i != num_half_tracks)) {
@@ -861,6 +901,7 @@ static int drive_snapshot_read_gcrimage_module(snapshot_t *s, unsigned int dnr)
     snapshot_module_t *m;
     char snap_module_name[10];
     uint8_t *data;
+    uint8_t encoding, fill;
     unsigned int i;
     drive_t *drive;
     uint32_t num_half_tracks, track_size;
@@ -882,7 +923,7 @@ static int drive_snapshot_read_gcrimage_module(snapshot_t *s, unsigned int dnr)
     }
 
     /* reject snapshot modules older than what we can handle (the snapshot is too old) */
-    if (snapshot_version_is_smaller(major_version, minor_version, GCRIMAGE_SNAP_MAJOR, GCRIMAGE_SNAP_MINOR)) {
+    if (snapshot_version_is_smaller(major_version, minor_version, GCRIMAGE_SNAP_MAJOR, GCRIMAGE_SNAP_MINOR_MIN)) {
         snapshot_set_error(SNAPSHOT_MODULE_INCOMPATIBLE);
         snapshot_module_close(m);
         return -1;
@@ -918,7 +959,26 @@ static int drive_snapshot_read_gcrimage_module(snapshot_t *s, unsigned int dnr)
         data = drive->gcr->tracks[i].data;
         drive->gcr->tracks[i].size = track_size;
 
-        if (track_size && SMR_BA(m, data, track_size) < 0) {
+        if (track_size == 0) {
+            continue;
+        }
+
+        /* older versions only have raw track data */
+        encoding = GCR_TRACK_RAW;
+        if (!snapshot_version_is_smaller(major_version, minor_version, GCRIMAGE_SNAP_MAJOR, GCRIMAGE_SNAP_MINOR_ENCODING)
+            && SMR_B(m, &encoding) < 0) {
+            snapshot_module_close(m);
+            return -1;
+        }
+
+        if (encoding == GCR_TRACK_FILL) {
+            if (SMR_B(m, &fill) < 0) {
+                snapshot_module_close(m);
+                return -1;
+            }
+            memset(data, fill, track_size);
+        } else if (encoding != GCR_TRACK_RAW
+                   || SMR_BA(m, data, track_size) < 0) {
             snapshot_module_close(m);
             return -1;
         }
@@ -956,8 +1016,8 @@ static int drive_snapshot_write_p64image_module(snapshot_t *s, unsigned int dnr)
     drive = diskunit_context[dnr]->drives[0];
     sprintf(snap_module_name, "P64IMAGE%u", dnr);
 
-    m = snapshot_module_create(s, snap_module_name, GCRIMAGE_SNAP_MAJOR,
-                               GCRIMAGE_SNAP_MINOR);
+    m = snapshot_module_create(s, snap_module_name, P64IMAGE_SNAP_MAJOR,
+                               P64IMAGE_SNAP_MINOR);
     if (m == NULL) {
         return -1;
     }
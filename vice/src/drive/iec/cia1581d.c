@@ -173,6 +173,10 @@ static void store_ciapb(cia_context_t *cia_context, CLOCK rclk, uint8_t byte)
                 (uint8_t)((((cia1581p->iecbus->cpu_port >> 4) & 0x4)
                             | (cia1581p->iecbus->cpu_port >> 7)
                             | ((cia1581p->iecbus->cpu_bus << 3) & 0x80)));
+
+            if (debug.bustrace) {
+                iec_drive_bus_trace(cia1581p->iecbus, cia1581p->number);
+            }
         } else {
             iec_drive_write((uint8_t)(~byte), cia1581p->number);
         }
@@ -786,6 +786,10 @@ static void undump_prb10(via_context_t *via_context, uint8_t byte)
         iecbus->drv_port = (((iecbus->cpu_port >> 4) & 0x4)
                             | (iecbus->cpu_port >> 7)
                             | ((iecbus->cpu_bus << 3) & 0x80));
+
+        if (debug.bustrace) {
+            iec_drive_bus_trace(iecbus, viap->number);
+        }
     } else {
         iec_drive_write((uint8_t)(~byte), viap->number);
     }
@@ -929,6 +933,10 @@ static void store_prb10(via_context_t *via_context, uint8_t byte, uint8_t oldpb,
                                 | (iecbus->cpu_port >> 7)
                                 | ((iecbus->cpu_bus << 3) & 0x80));
 
+            if (debug.bustrace) {
+                iec_drive_bus_trace(iecbus, viap->number);
+            }
+
             DEBUG_IEC_BUS_WRITE(iecbus->drv_port);
         } else {
             iec_drive_write((uint8_t)(~byte), viap->number);
@@ -30,6 +30,7 @@
 
 #include "cia.h"
 #include "ciad.h"
+#include "debug.h"
 #include "drive.h"
 #include "drivetypes.h"
 #include "iec-cmdline-options.h"
@@ -54,6 +55,17 @@
 static iecbus_t *drive_iecbus;
 
 
+/* Record the lines driven by drive \a dnr and the resulting ports after the
+   drive wrote to the bus, only call this if debug.bustrace is set */
+void iec_drive_bus_trace(const iecbus_t *bus, unsigned int dnr)
+{
+    uint32_t state = bus->drv_bus[dnr + 8] | (bus->cpu_port << 8)
+                     | (bus->drv_port << 16);
+
+    debug_bustrace(DEBUG_BUSTRACE_IEC, dnr + 8, DEBUG_BUSTRACE_DRIVE, state);
+}
+
+
 int iec_drive_resources_init(void)
 {
     return iec_resources_init();
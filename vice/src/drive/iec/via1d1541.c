@@ -203,6 +203,10 @@ static void undump_prb(via_context_t *via_context, uint8_t byte)
         iecbus->drv_port = (((iecbus->cpu_port >> 4) & 0x4)
                             | (iecbus->cpu_port >> 7)
                             | ((iecbus->cpu_bus << 3) & 0x80));
+
+        if (debug.bustrace) {
+            iec_drive_bus_trace(iecbus, via1p->number);
+        }
     } else {
         iec_drive_write((uint8_t)(~byte), via1p->number);
     }
@@ -239,6 +243,10 @@ static void store_prb(via_context_t *via_context, uint8_t byte, uint8_t p_oldpb,
                                 | (iecbus->cpu_port >> 7)
                                 | ((iecbus->cpu_bus << 3) & 0x80));
 
+            if (debug.bustrace) {
+                iec_drive_bus_trace(iecbus, via1p->number);
+            }
+
             DEBUG_IEC_BUS_WRITE(iecbus->drv_port);
         } else {
             iec_drive_write((uint8_t)(~byte), via1p->number);
@@ -89,6 +89,14 @@ static event_list_state_t *event_list = NULL;
 static event_image_list_t *event_image_list_base = NULL;
 static int image_number;
 
+/* Recycled event list nodes. Network play records, sends, replays and
+   clears a few small lists every frame, so keep the nodes around instead
+   of going through lib_calloc()/lib_free() for each of them. */
+#define EVENT_NODE_POOL_MAX 256
+
+static event_list_t *event_node_pool = NULL;
+static unsigned int event_node_pool_size = 0;
+
 static alarm_t *event_alarm = NULL;
 
 static log_t event_log = LOG_DEFAULT;
@@ -157,6 +165,43 @@ static int event_image_append(const char *filename, char **mapped_name, int appe
 }
 
 
+static event_list_t *event_node_new(void)
+{
+    event_list_t *node = event_node_pool;
+
+    if (node == NULL) {
+        return lib_calloc(1, sizeof(event_list_t));
+    }
+
+    event_node_pool = node->next;
+    event_node_pool_size--;
+    memset(node, 0, sizeof(event_list_t));
+    return node;
+}
+
+static void event_node_free(event_list_t *node)
+{
+    if (event_node_pool_size >= EVENT_NODE_POOL_MAX) {
+        lib_free(node);
+        return;
+    }
+
+    node->next = event_node_pool;
+    event_node_pool = node;
+    event_node_pool_size++;
+}
+
+static void event_node_pool_shutdown(void)
+{
+    while (event_node_pool != NULL) {
+        event_list_t *next = event_node_pool->next;
+
+        lib_free(event_node_pool);
+        event_node_pool = next;
+    }
+    event_node_pool_size = 0;
+}
+
 void event_record_attach_in_list(event_list_state_t *list, unsigned int unit,
                                  unsigned int drive,
                                  const char *filename, unsigned int read_only)
@@ -167,7 +212,7 @@ void event_record_attach_in_list(event_list_state_t *list, unsigned int unit,
 
     list->current->type = EVENT_ATTACHIMAGE;
     list->current->clk = maincpu_clk;
-    list->current->next = lib_calloc(1, sizeof(event_list_t));
+    list->current->next = event_node_new();
 
     util_fname_split(filename, &strdir, &strfile);
 
@@ -367,7 +412,7 @@ void event_record_in_list(event_list_state_t *list, unsigned int type,
         list->current->clk = maincpu_clk;
         list->current->size = size;
         list->current->data = event_data;
-        list->current->next = lib_calloc(1, sizeof(event_list_t));
+        list->current->next = event_node_new();
         list->current = list->current->next;
         list->current->type = EVENT_LIST_END;
     } else {
@@ -538,7 +583,7 @@ void event_playback_event_list(event_list_state_t *list)
 void event_register_event_list(event_list_state_t *list)
 {
     DBG(("event_register_event_list %p", list));
-    list->base = lib_calloc(1, sizeof(event_list_t));
+    list->base = event_node_new();
     list->current = list->base;
 }
 
@@ -565,7 +610,7 @@ static void cut_list(event_list_t *cut_base)
     while (c1 != NULL) {
         c2 = c1->next;
         lib_free(c1->data);
-        lib_free(c1);
+        event_node_free(c1);
         c1 = c2;
     }
 }
@@ -631,7 +676,7 @@ static void event_write_version(void)
         /* EVENT_INITIAL is missing (bug in 1.14.xx); fix it */
         event_list_t *new_event;
 
-        new_event = lib_calloc(1, sizeof(event_list_t));
+        new_event = event_node_new();
         new_event->clk = event_list->base->clk;
         new_event->size = (unsigned int)strlen(event_start_snapshot) + 2;
         new_event->type = EVENT_INITIAL;
@@ -1102,7 +1147,7 @@ int event_snapshot_read_module(struct snapshot_s *s, int event_mode)
                 curr->type = EVENT_TIMESTAMP;
                 curr->clk = next_timestamp_clk;
                 curr->size = 0;
-                curr->next = lib_calloc(1, sizeof(event_list_t));
+                curr->next = event_node_new();
                 curr = curr->next;
                 next_timestamp_clk += machine_get_cycles_per_second();
                 num_of_timestamps++;
@@ -1122,7 +1167,7 @@ int event_snapshot_read_module(struct snapshot_s *s, int event_mode)
             next_timestamp_clk -= clk;
         }
 
-        curr->next = lib_calloc(1, sizeof(event_list_t));
+        curr->next = event_node_new();
         curr = curr->next;
     }
 
@@ -1267,6 +1312,7 @@ void event_shutdown(void)
     lib_free(event_snapshot_path_str);
     event_snapshot_path_str = NULL;
     destroy_list();
+    event_node_pool_shutdown();
 }
 
 /*-----------------------------------------------------------------------*/
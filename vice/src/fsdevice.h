@@ -44,6 +44,7 @@ extern void fsdevice_init(void);
 extern void fsdevice_shutdown(void);
 
 extern int fsdevice_attach(unsigned int device, unsigned int drive, const char *name);
+extern void fsdevice_close_all(unsigned int unit);
 extern void fsdevice_set_directory(char *filename, unsigned int unit);
 
 #endif
@@ -40,22 +40,19 @@
 #include "fileio.h"
 #include "fsdevice-close.h"
 #include "fsdevice-read.h"
+#include "fsdevice-write.h"
 #include "fsdevicetypes.h"
 #include "archdep.h"
+#include "lib.h"
 #include "tape.h"
 #include "vdrive.h"
 
 
-int fsdevice_close(vdrive_t *vdrive, unsigned int secondary)
+/* Close the host file or directory of a channel, writing out data that is
+   still buffered for a file opened for writing.  */
+int fsdevice_close_channel(bufinfo_t *bufinfo)
 {
-    bufinfo_t *bufinfo;
-
-    bufinfo = &fsdevice_dev[vdrive->unit - 8].bufinfo[secondary];
-
-    if (secondary == 15) {
-        fsdevice_error(vdrive, CBMDOS_IPE_OK);
-        return FLOPPY_COMMAND_OK;
-    }
+    int rc = FLOPPY_COMMAND_OK;
 
     switch (bufinfo->mode) {
         case Relative:
@@ -68,12 +65,20 @@ int fsdevice_close(vdrive_t *vdrive, unsigned int secondary)
                 tape_image_close(bufinfo->tape);
             } else {
                 if (bufinfo->fileio_info != NULL) {
+                    if ((bufinfo->mode == Write || bufinfo->mode == Append)
+                        && fsdevice_write_flush(bufinfo) < 0) {
+                        rc = FLOPPY_ERROR;
+                    }
                     fileio_close(bufinfo->fileio_info);
                     bufinfo->fileio_info = NULL;
                 } else {
                     return FLOPPY_ERROR;
                 }
             }
+            lib_free(bufinfo->iobuf);
+            bufinfo->iobuf = NULL;
+            bufinfo->iobuf_len = 0;
+            bufinfo->iobuf_pos = 0;
             break;
         case Directory:
             if (bufinfo->host_dir == NULL) {
@@ -85,5 +90,19 @@ int fsdevice_close(vdrive_t *vdrive, unsigned int secondary)
             break;
     }
 
-    return FLOPPY_COMMAND_OK;
+    return rc;
+}
+
+int fsdevice_close(vdrive_t *vdrive, unsigned int secondary)
+{
+    bufinfo_t *bufinfo;
+
+    bufinfo = &fsdevice_dev[vdrive->unit - 8].bufinfo[secondary];
+
+    if (secondary == 15) {
+        fsdevice_error(vdrive, CBMDOS_IPE_OK);
+        return FLOPPY_COMMAND_OK;
+    }
+
+    return fsdevice_close_channel(bufinfo);
 }
@@ -29,8 +29,10 @@
 
 #include "types.h"
 
+struct bufinfo_s;
 struct vdrive_s;
 
 extern int fsdevice_close(struct vdrive_s *vdrive, unsigned int secondary);
+extern int fsdevice_close_channel(struct bufinfo_s *bufinfo);
 
 #endif
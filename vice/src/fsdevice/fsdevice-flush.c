@@ -67,8 +67,10 @@
 
 #define DRIVE_UNIT_MIN          8
 
-static int fsdevice_flush_reset(void)
+static int fsdevice_flush_reset(vdrive_t *vdrive)
 {
+    /* a reset closes all files, write out what is still buffered */
+    fsdevice_close_all(vdrive->unit);
     return CBMDOS_IPE_DOS_VERSION;
 }
 
@@ -791,9 +793,9 @@ void fsdevice_flush(vdrive_t *vdrive, unsigned int secondary)
         er = fsdevice_flush_rmdir(vdrive, realname);
         lib_free(realname);
     } else if ((!strcmp(cmd, "ui")) || (!strcmp(cmd, "u9"))) {
-        er = fsdevice_flush_reset();
+        er = fsdevice_flush_reset(vdrive);
     } else if ((!strcmp(cmd, "uj")) || (!strcmp(cmd, "u:"))) {
-        er = fsdevice_flush_reset();
+        er = fsdevice_flush_reset(vdrive);
     } else if (*cmd == 'i') { /* additional args for I are ignored */
         er = fsdevice_flush_initialize(vdrive);
     } else if (*cmd == 'v') { /* additional args for V are ignored */
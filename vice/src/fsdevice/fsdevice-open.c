@@ -425,6 +425,8 @@ int fsdevice_open(vdrive_t *vdrive, const uint8_t *name, unsigned int length,
     bufinfo[secondary].type = cmd_parse.filetype;
     bufinfo[secondary].reclen = cmd_parse.recordlength;
     bufinfo[secondary].num_records = -1;
+    bufinfo[secondary].iobuf_len = 0;
+    bufinfo[secondary].iobuf_pos = 0;
 
     cmd_parse.parsecmd[cmd_parse.parselength] = 0;
     strncpy(rname, cmd_parse.parsecmd, cmd_parse.parselength + 1);
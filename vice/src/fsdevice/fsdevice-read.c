@@ -61,6 +61,27 @@
 # define DBG(x)
 #endif
 
+/* Read the next byte of a file opened for reading from the host file,
+   refilling the buffer with a large block when it runs empty.  Return 1
+   if a byte was read, 0 on EOF and -1 on error.  */
+static int fileio_read_buffered(bufinfo_t *bufinfo, uint8_t *data)
+{
+    if (bufinfo->iobuf_pos >= bufinfo->iobuf_len) {
+        if (bufinfo->iobuf == NULL) {
+            bufinfo->iobuf = lib_malloc(FSDEVICE_IOBUF_SIZE);
+        }
+        bufinfo->iobuf_pos = 0;
+        bufinfo->iobuf_len = fileio_read(bufinfo->fileio_info, bufinfo->iobuf,
+                                         FSDEVICE_IOBUF_SIZE);
+        if (bufinfo->iobuf_len == 0) {
+            return fileio_ferror(bufinfo->fileio_info) ? -1 : 0;
+        }
+    }
+
+    *data = bufinfo->iobuf[bufinfo->iobuf_pos++];
+    return 1;
+}
+
 static int command_read(bufinfo_t *bufinfo, uint8_t *data)
 {
     if (bufinfo->tape->name) {
@@ -108,6 +129,8 @@ static int command_read(bufinfo_t *bufinfo, uint8_t *data)
         return SERIAL_OK;
     } else {
         if (bufinfo->fileio_info) {
+            int rc;
+
             /* If we are already at an EOF state, check next read, next stream
                may be available */
             if (bufinfo->iseof) {
@@ -120,21 +143,23 @@ static int command_read(bufinfo_t *bufinfo, uint8_t *data)
             }
             /* If this is our first read, read in first byte */
             if (!bufinfo->isbuffered) {
-                bufinfo->iseof = !fileio_read(bufinfo->fileio_info, &(bufinfo->buffered), 1);
+                rc = fileio_read_buffered(bufinfo, &(bufinfo->buffered));
                 /* We shouldn't get an EOF at this point */
                 /* Check for errors */
-                if (fileio_ferror(bufinfo->fileio_info)) {
+                if (rc < 0) {
                     return SERIAL_ERROR;
                 }
+                bufinfo->iseof = !rc;
             }
             /* Place it in the output field */
             *data = bufinfo->buffered;
             /* Read the next buffer; if nothing read, set EOF signal */
-            bufinfo->iseof = !fileio_read(bufinfo->fileio_info, &(bufinfo->buffered), 1);
+            rc = fileio_read_buffered(bufinfo, &(bufinfo->buffered));
             /* Check for errors */
-            if (fileio_ferror(bufinfo->fileio_info)) {
+            if (rc < 0) {
                 return SERIAL_ERROR;
             }
+            bufinfo->iseof = !rc;
             /* Indicate we have something in the buffer for the next read */
             bufinfo->isbuffered = 1;
             /* If the EOF was signaled, return a CBM EOF */
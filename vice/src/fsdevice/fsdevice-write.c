@@ -42,6 +42,7 @@
 #include "fsdevice-read.h"
 #include "fsdevice-write.h"
 #include "fsdevicetypes.h"
+#include "lib.h"
 #include "types.h"
 #include "vdrive.h"
 #include "vdrive/vdrive-command.h"
@@ -104,6 +105,27 @@ static void fsdevice_relfile_extend_if_needed(bufinfo_t *bufinfo)
     }
 }
 
+/* Write the data buffered for a channel opened for writing to the host
+   file.  Return 0 on success, -1 on error.  */
+int fsdevice_write_flush(bufinfo_t *bufinfo)
+{
+    unsigned int len;
+
+    if (bufinfo->iobuf_len == 0) {
+        return 0;
+    }
+
+    len = fileio_write(bufinfo->fileio_info, bufinfo->iobuf,
+                       bufinfo->iobuf_len);
+    if (len != bufinfo->iobuf_len) {
+        bufinfo->iobuf_len = 0;
+        return -1;
+    }
+
+    bufinfo->iobuf_len = 0;
+    return 0;
+}
+
 int fsdevice_write(struct vdrive_s *vdrive, uint8_t data, unsigned int secondary)
 {
     bufinfo_t *bufinfo;
@@ -155,6 +177,20 @@ int fsdevice_write(struct vdrive_s *vdrive, uint8_t data, unsigned int secondary
             }
         }
 
+        /* Sequential files are written in large blocks; the remainder is
+           written on close.  */
+        if (bufinfo->mode != Relative) {
+            if (bufinfo->iobuf == NULL) {
+                bufinfo->iobuf = lib_malloc(FSDEVICE_IOBUF_SIZE);
+            }
+            bufinfo->iobuf[bufinfo->iobuf_len++] = data;
+            if (bufinfo->iobuf_len == FSDEVICE_IOBUF_SIZE
+                && fsdevice_write_flush(bufinfo) < 0) {
+                return SERIAL_ERROR;
+            }
+            return SERIAL_OK;
+        }
+
         DBG(("fsdevice_write: recno:%d position_in_record:%d %02x '%c'",
                 bufinfo->current_record, bufinfo->position_in_record-1,
                 data, data));
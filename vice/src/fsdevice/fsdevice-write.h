@@ -35,5 +35,6 @@ struct bufinfo_s;
 extern void fsdevice_listen(struct vdrive_s *vdrive, unsigned int secondary);
 extern int fsdevice_write(struct vdrive_s *vdrive, uint8_t data,
                           unsigned int secondary);
+extern int fsdevice_write_flush(struct bufinfo_s *bufinfo);
 
 #endif
@@ -228,6 +228,28 @@ void fsdevice_init(void)
     }
 }
 
+/* Close all channels of a unit that still have a host file, directory or
+   tape image open, the same way CLOSE does, so data buffered for writing
+   is not lost when the device goes away.  */
+void fsdevice_close_all(unsigned int unit)
+{
+    bufinfo_t *bufinfo;
+    unsigned int j;
+
+    if (unit < 8 || unit >= 8 + FSDEVICE_DEVICE_MAX) {
+        return;
+    }
+
+    bufinfo = fsdevice_dev[unit - 8].bufinfo;
+
+    for (j = 0; j < FSDEVICE_BUFFER_MAX; j++) {
+        if (bufinfo[j].fileio_info != NULL || bufinfo[j].host_dir != NULL
+            || (bufinfo[j].tape != NULL && bufinfo[j].tape->name != NULL)) {
+            fsdevice_close_channel(&bufinfo[j]);
+        }
+    }
+}
+
 void fsdevice_shutdown(void)
 {
     unsigned int i, j;
@@ -235,6 +257,8 @@ void fsdevice_shutdown(void)
     for (i = 0; i < FSDEVICE_DEVICE_MAX; i++) {
         bufinfo_t *bufinfo;
 
+        fsdevice_close_all(i + 8);
+
         bufinfo = fsdevice_dev[i].bufinfo;
 
         for (j = 0; j < FSDEVICE_BUFFER_MAX; j++) {
@@ -242,6 +266,7 @@ void fsdevice_shutdown(void)
             lib_free(bufinfo[j].dir);
             lib_free(bufinfo[j].name);
             lib_free(bufinfo[j].dirmask);
+            lib_free(bufinfo[j].iobuf);
         }
 
         lib_free(fsdevice_dev[i].errorl);
@@ -36,6 +36,9 @@
 #define FSDEVICE_TRACK_MAX   80
 #define FSDEVICE_SECTOR_MAX  32
 
+/* Size of the host file I/O buffer of a channel.  */
+#define FSDEVICE_IOBUF_SIZE  0x10000
+
 enum fsmode {
     Write, Read, Append, Directory, Relative
 };
@@ -57,6 +60,9 @@ struct bufinfo_s {
     uint8_t buffered;  /* Buffered Byte: Added to buffer reads to remove buffering from iec code */
     int isbuffered; /* TRUE is a byte exists in the buffer above */
     int iseof;      /* TRUE if an EOF is detected on a buffered read */
+    uint8_t *iobuf; /* Read: data read ahead, Write/Append: data not yet written */
+    unsigned int iobuf_len; /* number of bytes in `iobuf' */
+    unsigned int iobuf_pos; /* Read: next byte to return from `iobuf' */
     char *dirmask;
                     /* REL file support */
     int reclen;
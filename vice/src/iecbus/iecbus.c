@@ -194,6 +194,21 @@ void debug_iec_bus_read(unsigned int data)
 
 #endif
 
+/* Record the lines driven by the computer and the resulting ports after the
+   computer changed them, only call this if debug.bustrace is set.  Changes
+   caused by the drives are recorded by the drives.  */
+static void iecbus_cpu_write_trace(void)
+{
+    static int old_cpu_bus = -1;
+
+    if (iecbus.cpu_bus != old_cpu_bus) {
+        old_cpu_bus = iecbus.cpu_bus;
+        debug_bustrace(DEBUG_BUSTRACE_IEC, 0, DEBUG_BUSTRACE_COMPUTER,
+                       iecbus.cpu_bus | (iecbus.cpu_port << 8)
+                       | (iecbus.drv_port << 16));
+    }
+}
+
 void iecbus_init(void)
 {
     memset(&iecbus, 0xff, sizeof(iecbus_t));
@@ -284,6 +299,10 @@ static void iecbus_cpu_write_conf1(uint8_t data, CLOCK clock)
                                     & 0x80));
     }
     iec_update_ports();
+
+    if (debug.bustrace) {
+        iecbus_cpu_write_trace();
+    }
 }
 
 /* Only the second disk unit (drive 9) is enabled.  */
@@ -348,6 +367,10 @@ static void iecbus_cpu_write_conf2(uint8_t data, CLOCK clock)
     }
 
     iec_update_ports();
+
+    if (debug.bustrace) {
+        iecbus_cpu_write_trace();
+    }
 }
 
 static uint8_t iecbus_cpu_read_conf3(CLOCK clock)
@@ -427,6 +450,10 @@ static void iecbus_cpu_write_conf3(uint8_t data, CLOCK clock)
     }
 
     iec_update_ports();
+
+    if (debug.bustrace) {
+        iecbus_cpu_write_trace();
+    }
 }
 
 static void calculate_callback_index(void)
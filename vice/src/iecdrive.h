@@ -34,6 +34,8 @@
 
 #include "types.h"
 
+struct iecbus_s;
+
 /* return value for iec_available_busses() (can be ored) */
 #define IEC_BUS_IEC     0x01    /* serial IEC bus */
 #define IEC_BUS_IEEE    0x02    /* parallel IEEE bus */
@@ -44,6 +46,7 @@ extern int iec_available_busses(void);
 extern void iec_update_ports_embedded(void);
 extern void iec_drive_write(uint8_t data, unsigned int dnr);
 extern uint8_t iec_drive_read(unsigned int dnr);
+extern void iec_drive_bus_trace(const struct iecbus_s *bus, unsigned int dnr);
 
 #define PARALLEL_WRITE    0 /* write data */
 #define PARALLEL_WRITE_HS 1 /* write data, set flag (cia2) */
@@ -104,4 +104,13 @@ extern char *image_contents_filename_by_number(image_contents_t *contents,
 
 extern image_contents_t *diskcontents_iec_read(unsigned int unit);
 
+#define IMAGE_CONTENTS_CACHE_DISK   0   /**< cached diskcontents_filesystem_read() */
+#define IMAGE_CONTENTS_CACHE_TAPE   1   /**< cached tapecontents_read() */
+
+extern int image_contents_cache_get(unsigned int kind, const char *path,
+                                    image_contents_t **contents);
+extern void image_contents_cache_put(unsigned int kind, const char *path,
+                                     const image_contents_t *contents);
+extern void image_contents_cache_shutdown(void);
+
 #endif
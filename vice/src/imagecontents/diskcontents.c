@@ -47,6 +47,10 @@ image_contents_t *diskcontents_filesystem_read(const char *file_name)
     vdrive_t *vdrive;
     image_contents_t *contents = NULL;
 
+    if (image_contents_cache_get(IMAGE_CONTENTS_CACHE_DISK, file_name, &contents)) {
+        return contents;
+    }
+
     vdrive = vdrive_internal_open_fsimage(file_name, 1);
 
     if (vdrive) {
@@ -54,5 +58,7 @@ image_contents_t *diskcontents_filesystem_read(const char *file_name)
         vdrive_internal_close_disk_image(vdrive);
     }
 
+    image_contents_cache_put(IMAGE_CONTENTS_CACHE_DISK, file_name, contents);
+
     return contents;
 }
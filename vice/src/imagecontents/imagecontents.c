@@ -38,7 +38,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
+#ifdef USE_VICE_THREAD
+#include <pthread.h>
+#endif
+
+#include "archdep.h"
 #include "charset.h"
 #include "diskcontents.h"
 #include "imagecontents.h"
@@ -346,3 +352,191 @@ char *image_contents_filename_by_number(image_contents_t *contents,
     return s;
 }
 
+
+/* ------------------------------------------------------------------------- */
+
+/* Cache of recently read directories. File browsers ask for the same image
+   again and again while the user moves through a directory, and smart
+   attach tries a disk read before a tape read for every file, each of
+   which opens and walks the whole image. */
+
+#define IMAGE_CONTENTS_CACHE_SIZE 16
+
+typedef struct image_contents_cache_s {
+    char *path;                 /**< file name, NULL if the entry is unused */
+    unsigned int kind;          /**< IMAGE_CONTENTS_CACHE_DISK/TAPE */
+    size_t len;                 /**< file size when it was read */
+    time_t mtime;               /**< modification time when it was read */
+    unsigned long stamp;        /**< last use, for LRU replacement */
+    image_contents_t *contents; /**< result of the read, may be NULL */
+} image_contents_cache_t;
+
+static image_contents_cache_t contents_cache[IMAGE_CONTENTS_CACHE_SIZE];
+static unsigned long contents_cache_stamp = 0;
+
+/* the file browsers read directories on the UI thread, autostart on the
+   VICE thread, so all access to the cache goes through this lock */
+#ifdef USE_VICE_THREAD
+static pthread_mutex_t contents_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define CACHE_LOCK()   pthread_mutex_lock(&contents_cache_lock)
+#define CACHE_UNLOCK() pthread_mutex_unlock(&contents_cache_lock)
+#else
+#define CACHE_LOCK()
+#define CACHE_UNLOCK()
+#endif
+
+
+/** \brief  Create a deep copy of \a contents
+ *
+ * \param[in]   contents    image contents object, may be `NULL`
+ *
+ * \return  copy, free with image_contents_destroy()
+ */
+static image_contents_t *image_contents_dup(const image_contents_t *contents)
+{
+    image_contents_t *copy;
+    image_contents_file_list_t *p, *lp = NULL;
+
+    if (contents == NULL) {
+        return NULL;
+    }
+
+    copy = lib_malloc(sizeof(image_contents_t));
+    *copy = *contents;
+    copy->file_list = NULL;
+
+    for (p = contents->file_list; p != NULL; p = p->next) {
+        image_contents_file_list_t *new_list;
+
+        new_list = lib_malloc(sizeof(image_contents_file_list_t));
+        *new_list = *p;
+        new_list->next = NULL;
+        new_list->prev = lp;
+        if (lp == NULL) {
+            copy->file_list = new_list;
+        } else {
+            lp->next = new_list;
+        }
+        lp = new_list;
+    }
+    return copy;
+}
+
+
+static void image_contents_cache_clear_entry(image_contents_cache_t *entry)
+{
+    lib_free(entry->path);
+    entry->path = NULL;
+    if (entry->contents != NULL) {
+        image_contents_destroy(entry->contents);
+        entry->contents = NULL;
+    }
+}
+
+
+/** \brief  Look up a previous read of \a path
+ *
+ * \param[in]   kind        IMAGE_CONTENTS_CACHE_DISK or IMAGE_CONTENTS_CACHE_TAPE
+ * \param[in]   path        file name
+ * \param[out]  contents    copy of the cached result (can be `NULL` if the
+ *                          file could not be read as this kind of image),
+ *                          free with image_contents_destroy()
+ *
+ * \return  1 if the file is cached and unchanged since, 0 otherwise
+ */
+int image_contents_cache_get(unsigned int kind, const char *path,
+                             image_contents_t **contents)
+{
+    size_t len;
+    time_t mtime;
+    int i;
+
+    if (path == NULL || archdep_stat_mtime(path, &len, &mtime) < 0) {
+        return 0;
+    }
+
+    CACHE_LOCK();
+    for (i = 0; i < IMAGE_CONTENTS_CACHE_SIZE; i++) {
+        image_contents_cache_t *entry = &contents_cache[i];
+
+        if (entry->path != NULL && entry->kind == kind
+            && strcmp(entry->path, path) == 0) {
+            if (entry->len != len || entry->mtime != mtime) {
+                /* file changed */
+                image_contents_cache_clear_entry(entry);
+                CACHE_UNLOCK();
+                return 0;
+            }
+            entry->stamp = ++contents_cache_stamp;
+            *contents = image_contents_dup(entry->contents);
+            CACHE_UNLOCK();
+            return 1;
+        }
+    }
+    CACHE_UNLOCK();
+    return 0;
+}
+
+
+/** \brief  Remember the result of reading \a path
+ *
+ * Files modified in the last two seconds are not cached, a later change in
+ * the same second would not be noticed by the modification time.
+ *
+ * \param[in]   kind        IMAGE_CONTENTS_CACHE_DISK or IMAGE_CONTENTS_CACHE_TAPE
+ * \param[in]   path        file name
+ * \param[in]   contents    result of the read, may be `NULL`
+ */
+void image_contents_cache_put(unsigned int kind, const char *path,
+                              const image_contents_t *contents)
+{
+    image_contents_cache_t *entry;
+    size_t len;
+    time_t mtime;
+    int i;
+
+    if (path == NULL || archdep_stat_mtime(path, &len, &mtime) < 0
+        || mtime + 2 > time(NULL)) {
+        return;
+    }
+
+    CACHE_LOCK();
+    entry = &contents_cache[0];
+
+    /* replace an entry for the same file, else the least recently used */
+    for (i = 0; i < IMAGE_CONTENTS_CACHE_SIZE; i++) {
+        if (contents_cache[i].path != NULL && contents_cache[i].kind == kind
+            && strcmp(contents_cache[i].path, path) == 0) {
+            entry = &contents_cache[i];
+            break;
+        }
+        if (contents_cache[i].stamp < entry->stamp) {
+            entry = &contents_cache[i];
+        }
+    }
+
+    image_contents_cache_clear_entry(entry);
+    entry->path = lib_strdup(path);
+    entry->kind = kind;
+    entry->len = len;
+    entry->mtime = mtime;
+    entry->stamp = ++contents_cache_stamp;
+    entry->contents = image_contents_dup(contents);
+    CACHE_UNLOCK();
+}
+
+
+/** \brief  Free all cached directories
+ */
+void image_contents_cache_shutdown(void)
+{
+    int i;
+
+    CACHE_LOCK();
+    for (i = 0; i < IMAGE_CONTENTS_CACHE_SIZE; i++) {
+        image_contents_cache_clear_entry(&contents_cache[i]);
+        contents_cache[i].stamp = 0;
+    }
+    CACHE_UNLOCK();
+}
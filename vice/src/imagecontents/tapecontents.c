@@ -90,9 +90,14 @@ image_contents_t *tapecontents_read(const char *file_name)
     tape_image_t *tape_image;
     image_contents_t *new;
 
+    if (image_contents_cache_get(IMAGE_CONTENTS_CACHE_TAPE, file_name, &new)) {
+        return new;
+    }
+
     tape_image = tape_internal_open_tape_image(file_name, 1);
 
     if (tape_image == NULL || tape_image->name == NULL) {
+        image_contents_cache_put(IMAGE_CONTENTS_CACHE_TAPE, file_name, NULL);
         return NULL;
     }
 
@@ -105,5 +110,7 @@ image_contents_t *tapecontents_read(const char *file_name)
     tape_read_contents(tape_image, new);
 
     tape_internal_close_tape_image(tape_image);
+
+    image_contents_cache_put(IMAGE_CONTENTS_CACHE_TAPE, file_name, new);
     return new;
 }
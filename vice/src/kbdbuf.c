@@ -49,7 +49,11 @@
 
 
 /* Maximum number of characters we can queue.  */
-#define QUEUE_SIZE      16384
+#define QUEUE_SIZE      65536
+
+/* Number of cycles between checks for an empty Kernal buffer in fast
+   feed mode.  */
+#define FAST_FEED_CYCLES    1000
 
 /* First location of the buffer.  */
 static int buffer_location;
@@ -85,6 +89,14 @@ static int use_kbdbuf_flush_alarm = 0;
 
 static alarm_t *kbdbuf_flush_alarm = NULL;
 
+/* Flag: refill the Kernal buffer as soon as it is empty, instead of once
+   per frame.  */
+static int KbdbufFastFeed = 0;
+
+static alarm_t *kbdbuf_feed_alarm = NULL;
+
+static int kbdbuf_feed_alarm_pending = 0;
+
 /* Only feed the cmdline -kbdbuf argument to the buffer once */
 static bool kbdbuf_init_cmdline_fed = false;
 
@@ -102,10 +114,19 @@ static int set_kbdbuf_delay(int val, void *param)
     return 0;
 }
 
+/*! \internal \brief enable/disable refilling the buffer as soon as it is empty */
+static int set_kbdbuf_fast_feed(int val, void *param)
+{
+    KbdbufFastFeed = val ? 1 : 0;
+    return 0;
+}
+
 /*! \brief integer resources used by keybuf */
 static const resource_int_t resources_int[] = {
     { "KbdbufDelay", 0, RES_EVENT_NO, (resource_value_t)0,
       &KbdbufDelay, set_kbdbuf_delay, NULL },
+    { "KbdbufFastFeed", 0, RES_EVENT_NO, (resource_value_t)0,
+      &KbdbufFastFeed, set_kbdbuf_fast_feed, NULL },
     RESOURCE_INT_LIST_END
 };
 
@@ -193,6 +214,12 @@ static const cmdline_option_t cmdline_options[] =
     { "-keybuf-delay", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
       NULL, NULL, "KbdbufDelay", NULL,
       "<value>", "Set additional keyboard buffer delay (0: use default)" },
+    { "-keybuf-fast", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "KbdbufFastFeed", (resource_value_t)1,
+      NULL, "Refill the keyboard buffer as soon as it is empty" },
+    { "+keybuf-fast", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "KbdbufFastFeed", (resource_value_t)0,
+      NULL, "Refill the keyboard buffer once per frame" },
     CMDLINE_LIST_END
 };
 
@@ -276,6 +303,14 @@ static void kbdbuf_flush_alarm_triggered(CLOCK offset, void *data)
     removefromqueue();
 }
 
+static void kbdbuf_feed_alarm_triggered(CLOCK offset, void *data)
+{
+    alarm_unset(kbdbuf_feed_alarm);
+    kbdbuf_feed_alarm_pending = 0;
+
+    kbdbuf_flush();
+}
+
 void kbdbuf_reset(int location, int plocation, int size, CLOCK mincycles)
 {
     buffer_location = location;
@@ -283,6 +318,11 @@ void kbdbuf_reset(int location, int plocation, int size, CLOCK mincycles)
     buffer_size = size;
     kernal_init_cycles = mincycles;
 
+    if (kbdbuf_feed_alarm_pending) {
+        alarm_unset(kbdbuf_feed_alarm);
+        kbdbuf_feed_alarm_pending = 0;
+    }
+
     if (mincycles) {
         kbd_buf_enabled = 1;
     } else {
@@ -299,6 +339,7 @@ void kbdbuf_init(int location, int plocation, int size, CLOCK mincycles)
         mincycles += KbdbufDelay;
     }
     kbdbuf_flush_alarm = alarm_new(maincpu_alarm_context, "Keybuf", kbdbuf_flush_alarm_triggered, NULL);
+    kbdbuf_feed_alarm = alarm_new(maincpu_alarm_context, "KeybufFeed", kbdbuf_feed_alarm_triggered, NULL);
     kbdbuf_reset(location, plocation, size, mincycles);
     /* printf("kbdbuf_init cmdline_get_autostart_mode(): %d\n", cmdline_get_autostart_mode()); */
     /* inject string given to -keybuf option on commandline into keyboard buffer,
@@ -334,6 +375,20 @@ int kbdbuf_feed_runcmd(const char *string)
     return string_to_queue(string);
 }
 
+/* In fast feed mode, check again for an empty Kernal buffer in a short
+   while, so the queue is not drained at the frame rate only.  */
+static void kbdbuf_schedule_feed(void)
+{
+    if (KbdbufFastFeed
+        && kbd_buf_enabled
+        && num_pending > 0
+        && !kbdbuf_feed_alarm_pending
+        && kbdbuf_feed_alarm != NULL) {
+        kbdbuf_feed_alarm_pending = 1;
+        alarm_set(kbdbuf_feed_alarm, maincpu_clk + FAST_FEED_CYCLES);
+    }
+}
+
 /* Flush pending characters into the kernal's queue if possible.
    This is (at least) called once per frame in vsync handler */
 void kbdbuf_flush(void)
@@ -353,6 +408,7 @@ void kbdbuf_flush(void)
         || !kbdbuf_is_empty()
         || (maincpu_clk < kernal_init_cycles)
         || (kbdbuf_flush_alarm_time != 0)) {
+        kbdbuf_schedule_feed();
         prevent_recursion = false;
         return;
     }
@@ -374,5 +430,6 @@ void kbdbuf_flush(void)
         removefromqueue();
     }
 
+    kbdbuf_schedule_feed();
     prevent_recursion = false;
 }
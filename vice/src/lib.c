@@ -962,6 +962,8 @@ double lib_double_rand_unit(void)
 }
 
 static uint64_t initalseed;
+static int initalseed_given = 0;
+
 void lib_rand_printseed(void)
 {
     log_message(LOG_DEFAULT, "random seed was: 0x%"PRIx64, initalseed);
@@ -970,10 +972,29 @@ void lib_rand_printseed(void)
 void lib_rand_seed(uint64_t seed)
 {
     initalseed = seed;
+    initalseed_given = 1;
     srand((unsigned int)seed);
     rand_seed((uint64_t)seed);
 }
 
+/* Return the seed, or 0 if it was not given but taken from the current
+ * time.  */
+uint64_t lib_rand_get_seed(void)
+{
+    return initalseed_given ? initalseed : 0;
+}
+
+/* Get/set the generator state, for snapshots.  */
+uint64_t lib_rand_get_state(void)
+{
+    return rand_state;
+}
+
+void lib_rand_set_state(uint64_t state)
+{
+    rand_state = state;
+}
+
 void lib_init(void)
 {
 #ifdef DEBUG
@@ -995,6 +1016,7 @@ void lib_init(void)
      * startup, at all.
      */
     lib_rand_seed((uint64_t)time(NULL));
+    initalseed_given = 0;
 }
 
 
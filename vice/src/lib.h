@@ -49,6 +49,9 @@ extern double lib_double_rand_unit(void);
 
 extern void lib_rand_seed(uint64_t seed);
 extern void lib_rand_printseed(void);
+extern uint64_t lib_rand_get_seed(void);
+extern uint64_t lib_rand_get_state(void);
+extern void lib_rand_set_state(uint64_t state);
 
 extern char *lib_msprintf(const char *fmt, ...) VICE_ATTR_PRINTF;
 extern char *lib_mvsprintf(const char *fmt, va_list args);
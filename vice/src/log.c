@@ -33,6 +33,20 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef USE_VICE_THREAD
+#include <pthread.h>
+
+/* the UI thread logs too, the lock covers the log list, the repeat state
+   and the writes to the log file */
+static pthread_mutex_t log_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define LOCK()   pthread_mutex_lock(&log_lock)
+#define UNLOCK() pthread_mutex_unlock(&log_lock)
+#else
+#define LOCK()
+#define UNLOCK()
+#endif
+
 #include "archdep.h"
 #include "cmdline.h"
 #include "lib.h"
@@ -55,25 +69,36 @@ static int log_enabled = 1; /* cv: this flag allows to temporarly disable all lo
 static int verbose = 0;
 static int locked = 0;
 
+/* the last message written, identical messages that follow it are only
+   counted and summarized once something else gets logged */
+static char *last_txt = NULL;
+static signed int last_logi = 0;
+static unsigned int last_level = 0;
+static unsigned int last_repeat = 0;
+
+static void log_flush_repeats(void);
+
 /* ------------------------------------------------------------------------- */
 
 static char *log_file_name = NULL;
 
-static void log_file_open(void)
+static FILE *log_file_open(void)
 {
+    FILE *f;
+
     if (log_file_name == NULL || *log_file_name == 0) {
-        log_file = archdep_open_default_log_file();
+        f = archdep_open_default_log_file();
     } else {
         if (strcmp(log_file_name, "-") == 0) {
-            log_file = stdout;
+            f = stdout;
         } else {
-            log_file = fopen(log_file_name, MODE_WRITE_TEXT);
+            f = fopen(log_file_name, MODE_WRITE_TEXT);
         }
     }
-    /* flush all data direct to the output stream. */
-    if (log_file) {
-        setbuf(log_file, NULL);
-    }
+    /* log_helper() flushes after every message, so the stream can stay
+       buffered and a message is written with one call instead of one
+       per fputs/vfprintf/fputc. */
+    return f;
 }
 
 static int set_log_file_name(const char *val, void *param)
@@ -87,8 +112,17 @@ static int set_log_file_name(const char *val, void *param)
     }
 
     if (log_file) {
-        fclose(log_file);
-        log_file_open();
+        FILE *f;
+
+        /* opening the default log file may log an error itself, so the
+           lock is not held while opening */
+        f = log_file_open();
+        LOCK();
+        if (log_file != f) {
+            fclose(log_file);
+        }
+        log_file = f;
+        UNLOCK();
     }
 
     return 0;
@@ -216,7 +250,7 @@ int log_init(void)
     }
 #endif
 
-    log_file_open();
+    log_file = log_file_open();
 
     return (log_file == NULL) ? -1 : 0;
 }
@@ -226,6 +260,7 @@ log_t log_open(const char *id)
     log_t new_log = 0;
     log_t i;
 
+    LOCK();
     for (i = 0; i < num_logs; i++) {
         if (logs[i] == NULL) {
             new_log = i;
@@ -238,6 +273,7 @@ log_t log_open(const char *id)
     }
 
     logs[new_log] = lib_strdup(id);
+    UNLOCK();
 
     /* printf("log_open(%s) = %d\n", id, (int)new_log); */
     return new_log;
@@ -246,12 +282,15 @@ log_t log_open(const char *id)
 int log_close(log_t log)
 {
     /* printf("log_close(%d)\n", (int)log); */
+    LOCK();
     if (logs[(unsigned int)log] == NULL) {
+        UNLOCK();
         return -1;
     }
 
     lib_free(logs[(unsigned int)log]);
     logs[(unsigned int)log] = NULL;
+    UNLOCK();
 
     return 0;
 }
@@ -260,23 +299,28 @@ void log_close_all(void)
 {
     log_t i;
 
+    LOCK();
+    log_flush_repeats();
+    lib_free(last_txt);
+    last_txt = NULL;
+
     for (i = 0; i < num_logs; i++) {
-        log_close(i);
+        lib_free(logs[i]);
+        logs[i] = NULL;
     }
 
     lib_free(logs);
     logs = NULL;
+    UNLOCK();
 }
 
-static int log_archdep(const char *logtxt, const char *fmt, va_list ap)
+static int log_archdep(const char *logtxt, char *txt)
 {
     /*
      * ------ Split into single lines ------
      */
     int rc = 0;
 
-    char *txt = lib_mvsprintf(fmt, ap);
-
     char *beg = txt;
     char *end = txt + strlen(txt) + 1;
 
@@ -287,69 +331,120 @@ static int log_archdep(const char *logtxt, const char *fmt, va_list ap)
             *eol = '\0';
         }
 
-        if (archdep_default_logger(*beg ? logtxt : "", beg) < 0) {
-            rc = -1;
+        rc = archdep_default_logger(*beg ? logtxt : "", beg);
+
+        if (!eol) {
             break;
         }
 
-        if (!eol) {
+        /* txt is kept for repeat detection, so restore it */
+        *eol = '\n';
+
+        if (rc < 0) {
             break;
         }
 
         beg = eol + 1;
     }
 
-    lib_free(txt);
+    return rc < 0 ? -1 : 0;
+}
+
+static const char * const level_strings[3] = {
+    "",
+    "Warning - ",
+    "Error - "
+};
+
+static int log_write(signed int logi, unsigned int level, char *txt)
+{
+    int rc = 0;
+    char *logtxt = NULL;
+
+    if ((log_file != NULL) && (logi != LOG_DEFAULT) && (logi != LOG_ERR)
+        && (logs != NULL) && (logi < num_logs) && (logs[logi] != NULL)
+        && (*logs[logi] != '\0')) {
+        logtxt = lib_msprintf("%s: %s", logs[logi], level_strings[level]);
+    } else {
+        logtxt = lib_msprintf("%s", level_strings[level]);
+    }
+
+    if (log_file == NULL) {
+        rc = log_archdep(logtxt, txt);
+    } else {
+#ifdef ARCHDEP_EXTRA_LOG_CALL
+        log_archdep(logtxt, txt);
+#endif
+        if (fputs(logtxt, log_file) == EOF
+            || fputs(txt, log_file) == EOF
+            || fputc ('\n', log_file) == EOF
+            || fflush(log_file) == EOF) {
+            rc = -1;
+        }
+    }
+
+    lib_free(logtxt);
 
     return rc;
 }
 
+/* write the summary of repeated messages, if any */
+static void log_flush_repeats(void)
+{
+    if (last_repeat > 0) {
+        char *txt = lib_msprintf("(last message repeated %u times)", last_repeat);
+
+        last_repeat = 0;
+        log_write(last_logi, last_level, txt);
+        lib_free(txt);
+    }
+}
+
 static int log_helper(log_t log, unsigned int level, const char *format,
                       va_list ap)
 {
-    static const char * const level_strings[3] = {
-        "",
-        "Warning - ",
-        "Error - "
-    };
-
     const signed int logi = (signed int)log;
-    int rc = 0;
-    char *logtxt = NULL;
+    int rc;
+    char *txt;
 
     if (!log_enabled) {
         return 0;
     }
 
+    /* format once, the text is also needed to spot repeated messages */
+    txt = lib_mvsprintf(format, ap);
+
+    LOCK();
     if ((logi != LOG_DEFAULT) && (logi != LOG_ERR)) {
         if ((logs == NULL) || (logi < 0)|| (logi >= num_logs) || (logs[logi] == NULL)) {
+            UNLOCK();
 #ifdef DEBUG
-            log_archdep("log_helper: internal error (invalid id or closed log), messages follows:\n", format, ap);
+            log_archdep("log_helper: internal error (invalid id or closed log), messages follows:\n", txt);
 #endif
+            lib_free(txt);
             return -1;
         }
     }
 
-    if ((log_file != NULL) && (logi != LOG_DEFAULT) && (logi != LOG_ERR) && (*logs[logi] != '\0')) {
-        logtxt = lib_msprintf("%s: %s", logs[logi], level_strings[level]);
-    } else {
-        logtxt = lib_msprintf("%s", level_strings[level]);
+    if ((last_txt != NULL) && (logi == last_logi) && (level == last_level)
+        && (strcmp(txt, last_txt) == 0)) {
+        /* bursts of the same message (e.g. buffer overflows) should not
+           stall the emulation with output */
+        last_repeat++;
+        UNLOCK();
+        lib_free(txt);
+        return 0;
     }
 
-    if (log_file == NULL) {
-        rc = log_archdep(logtxt, format, ap);
-    } else {
-#ifdef ARCHDEP_EXTRA_LOG_CALL
-        log_archdep(logtxt, format, ap);
-#endif
-        if (fputs(logtxt, log_file) == EOF
-            || vfprintf(log_file, format, ap) < 0
-            || fputc ('\n', log_file) == EOF) {
-            rc = -1;
-        }
-    }
+    log_flush_repeats();
 
-    lib_free(logtxt);
+    rc = log_write(logi, level, txt);
+
+    lib_free(last_txt);
+    last_txt = txt;
+    last_logi = logi;
+    last_level = level;
+    UNLOCK();
 
     return rc;
 }
@@ -36,12 +36,14 @@
 #include "autostart.h"
 #include "cmdline.h"
 #include "console.h"
+#include "debug.h"
 #include "diskimage.h"
 #include "drive.h"
 #include "vice-event.h"
 #include "fliplist.h"
 #include "fsdevice.h"
 #include "gfxoutput.h"
+#include "imagecontents.h"
 #include "initcmdline.h"
 #include "interrupt.h"
 #include "joystick.h"
@@ -61,6 +63,7 @@
 #include "resources.h"
 #include "romset.h"
 #include "screenshot.h"
+#include "snapshot.h"
 #include "sound.h"
 #include "sysfile.h"
 #include "tape.h"
@@ -93,6 +96,7 @@ static int jam_action = MACHINE_JAM_ACTION_DIALOG;
 int machine_keymap_index;
 static char *ExitScreenshotName = NULL;
 static char *ExitScreenshotName1 = NULL;
+static int deterministic = 0;
 
 /* NOTE: this function is very similar to drive_jam - in case the behavior
          changes, change drive_jam too */
@@ -255,6 +259,14 @@ int machine_init(void)
 {
     machine_init_was_called = 1;
 
+    if (deterministic) {
+        /* Restart the random number generator from the given seed (or 0),
+           so nothing that ran before makes a difference.  */
+        lib_rand_seed(lib_rand_get_seed());
+        log_message(LOG_DEFAULT, "Deterministic mode, random seed is 0x%"PRIx64".",
+                    lib_rand_get_seed());
+    }
+
     fsdevice_init();
     file_system_init();
     mem_initialize_memory();
@@ -326,6 +338,8 @@ void machine_shutdown(void)
     screenshot_at_exit();
     screenshot_shutdown();
 
+    debug_shutdown();
+
     file_system_detach_disk_shutdown();
 
     machine_specific_shutdown();
@@ -347,6 +361,7 @@ void machine_shutdown(void)
     fsdevice_shutdown();
 
     tape_shutdown();
+    image_contents_cache_shutdown();
 
     traps_shutdown();
 
@@ -426,6 +441,22 @@ static int set_jam_action(int val, void *param)
     return 0;
 }
 
+/* only set from the command line like -seed, which it depends on; a saved
+   setting would silently freeze the RTCs in every later session */
+static int deterministic_opt(const char *param, void *extra_param)
+{
+    deterministic = 1;
+
+    return 0;
+}
+
+/* Returns 1 if all randomness is taken from the -seed value and the RTCs
+   run on emulated time, so runs can be repeated exactly.  */
+int machine_is_deterministic(void)
+{
+    return deterministic;
+}
+
 static int set_exit_screenshot_name(const char *val, void *param)
 {
     if (util_string_set(&ExitScreenshotName, val)) {
@@ -473,6 +504,9 @@ int machine_common_resources_init(void)
             return -1;
             }
         }
+        if (screenshot_resources_init() < 0) {
+            return -1;
+        }
     }
     return resources_register_int(resources_int);
 }
@@ -481,6 +515,7 @@ void machine_common_resources_shutdown(void)
 {
     lib_free(ExitScreenshotName);
     lib_free(ExitScreenshotName1);
+    screenshot_resources_shutdown();
 }
 
 static const cmdline_option_t cmdline_options_c128[] =
@@ -488,6 +523,9 @@ static const cmdline_option_t cmdline_options_c128[] =
     { "-jamaction", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
       NULL, NULL, "JAMAction", NULL,
       "<Type>", "Set action on CPU JAM: (0: Ask, 1: continue, 2: Monitor, 3: Reset, 4: Hard Reset, 5: Quit Emulator)" },
+    { "-deterministic", CALL_FUNCTION, CMDLINE_ATTRIB_NONE,
+      deterministic_opt, NULL, NULL, NULL,
+      NULL, "Take all randomness from the -seed value and run RTCs on emulated time, without saved RTC state" },
     { "-exitscreenshot", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
       NULL, NULL, "ExitScreenshotName", NULL,
       "<Name>", "Set name of screenshot to save when emulator exits." },
@@ -502,6 +540,9 @@ static const cmdline_option_t cmdline_options[] =
     { "-jamaction", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
       NULL, NULL, "JAMAction", NULL,
       "<Type>", "Set action on CPU JAM: (0: Ask, 1: continue, 2: Monitor, 3: Reset, 4: Hard Reset, 5: Quit Emulator)" },
+    { "-deterministic", CALL_FUNCTION, CMDLINE_ATTRIB_NONE,
+      deterministic_opt, NULL, NULL, NULL,
+      NULL, "Take all randomness from the -seed value and run RTCs on emulated time, without saved RTC state" },
     { "-exitscreenshot", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
       NULL, NULL, "ExitScreenshotName", NULL,
       "<Name>", "Set name of screenshot to save when emulator exits." },
@@ -513,16 +554,92 @@ static const cmdline_option_t cmdline_options_vsid[] =
     { "-jamaction", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
       NULL, NULL, "JAMAction", NULL,
       "<Type>", "Set action on CPU JAM: (0: Ask, 1: continue, 2: Monitor, 3: Reset, 4: Hard Reset, 5: Quit Emulator)" },
+    { "-deterministic", CALL_FUNCTION, CMDLINE_ATTRIB_NONE,
+      deterministic_opt, NULL, NULL, NULL,
+      NULL, "Take all randomness from the -seed value and run RTCs on emulated time, without saved RTC state" },
     CMDLINE_LIST_END
 };
 
 int machine_common_cmdline_options_init(void)
 {
+    if (machine_class == VICE_MACHINE_VSID) {
+        return cmdline_register_options(cmdline_options_vsid);
+    }
+    if (screenshot_cmdline_options_init() < 0) {
+        return -1;
+    }
     if (machine_class == VICE_MACHINE_C128) {
         return cmdline_register_options(cmdline_options_c128);
-    } else if (machine_class == VICE_MACHINE_VSID) {
-        return cmdline_register_options(cmdline_options_vsid);
     } else {
         return cmdline_register_options(cmdline_options);
     }
 }
+
+/* --------------------------------------------------------- */
+/* Snapshot */
+
+#define SNAP_MAJOR 1
+#define SNAP_MINOR 0
+static const char snap_module_name[] = "RANDOM";
+
+/* Save the random seed and the state of the random number generator.  */
+int machine_common_snapshot_write_module(snapshot_t *s)
+{
+    snapshot_module_t *m;
+
+    m = snapshot_module_create(s, snap_module_name, SNAP_MAJOR, SNAP_MINOR);
+
+    if (m == NULL) {
+        return -1;
+    }
+
+    if (0
+        || SMW_B(m, (uint8_t)deterministic) < 0
+        || SMW_QW(m, lib_rand_get_seed()) < 0
+        || SMW_QW(m, lib_rand_get_state()) < 0) {
+        snapshot_module_close(m);
+        return -1;
+    }
+
+    return snapshot_module_close(m);
+}
+
+/* The generator state is only restored in deterministic mode, to keep
+   other runs random after loading a snapshot.  */
+int machine_common_snapshot_read_module(snapshot_t *s)
+{
+    uint8_t major_version, minor_version;
+    snapshot_module_t *m;
+    uint8_t snap_deterministic;
+    uint64_t seed, state;
+
+    m = snapshot_module_open(s, snap_module_name, &major_version, &minor_version);
+
+    if (m == NULL) {
+        return 0;
+    }
+
+    /* Do not accept versions higher than current */
+    if (snapshot_version_is_bigger(major_version, minor_version, SNAP_MAJOR, SNAP_MINOR)) {
+        snapshot_set_error(SNAPSHOT_MODULE_HIGHER_VERSION);
+        snapshot_module_close(m);
+        return -1;
+    }
+
+    if (0
+        || SMR_B(m, &snap_deterministic) < 0
+        || SMR_QW(m, &seed) < 0
+        || SMR_QW(m, &state) < 0) {
+        snapshot_module_close(m);
+        return -1;
+    }
+
+    if (deterministic) {
+        if (!snap_deterministic) {
+            log_warning(LOG_DEFAULT, "Snapshot was not saved in deterministic mode.");
+        }
+        lib_rand_set_state(state);
+    }
+
+    return snapshot_module_close(m);
+}
@@ -142,6 +142,14 @@ extern int machine_write_snapshot(const char *name, int save_roms,
 /* Read a snapshot.  */
 extern int machine_read_snapshot(const char *name, int even_mode);
 
+/* Snapshot module for the machine independent state (random seed).  */
+struct snapshot_s;
+extern int machine_common_snapshot_write_module(struct snapshot_s *s);
+extern int machine_common_snapshot_read_module(struct snapshot_s *s);
+
+/* Returns 1 if -deterministic was given on the command line.  */
+extern int machine_is_deterministic(void);
+
 /* handle pending interrupts - needed by libsid.a.  */
 extern void machine_handle_pending_alarms(CLOCK num_write_cycles);
 
@@ -393,6 +393,10 @@ void maincpu_set_carry(int c) {
     WDC65816_REGS_SET_CARRY(&maincpu_regs, c);
 }
 
+void maincpu_set_overflow(int v) {
+    WDC65816_REGS_SET_OVERFLOW(&maincpu_regs, v);
+}
+
 void maincpu_set_interrupt(int i) {
     WDC65816_REGS_SET_INTERRUPT(&maincpu_regs, i);
 }
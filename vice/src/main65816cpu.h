@@ -65,6 +65,7 @@ extern void maincpu_set_y(int);
 extern void maincpu_set_sign(int);
 extern void maincpu_set_zero(int);
 extern void maincpu_set_carry(int);
+extern void maincpu_set_overflow(int);
 extern void maincpu_set_interrupt(int);
 extern unsigned int maincpu_get_pc(void);
 extern unsigned int maincpu_get_a(void);
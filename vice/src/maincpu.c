@@ -640,6 +640,14 @@ void maincpu_set_carry(int c) {
 #endif
 }
 
+void maincpu_set_overflow(int v) {
+#ifdef C64DTV
+    MOS6510DTV_REGS_SET_OVERFLOW(&maincpu_regs, v);
+#else
+    MOS6510_REGS_SET_OVERFLOW(&maincpu_regs, v);
+#endif
+}
+
 void maincpu_set_interrupt(int i) {
 #ifdef C64DTV
     MOS6510DTV_REGS_SET_INTERRUPT(&maincpu_regs, i);
@@ -43,6 +43,7 @@
 
 #include "archdep.h"
 #include "debug.h"
+#include "lib.h"
 #include "log.h"
 #include "machine.h"
 #include "mainlock.h"
@@ -63,11 +64,105 @@ static pthread_t        vice_thread;
 static bool             vice_thread_keepalive  = true;
 static bool             vice_thread_is_running = false;
 
+/*
+ * Commands posted by the UI with mainlock_post(). They are queued under
+ * internal_lock only, so the VICE thread never stops for them: it picks the
+ * whole list up in mainlock_yield_begin() and runs it in mainlock_yield_end()
+ * once it holds the main lock again.
+ */
+typedef struct mainlock_command_s {
+    mainlock_callback_t callback;
+    void *param;
+    struct mainlock_command_s *next;
+} mainlock_command_t;
+
+static mainlock_command_t *posted_head = NULL;
+static mainlock_command_t *posted_tail = NULL;
+
+/* Commands taken from the queue by the VICE thread, to be run next */
+static mainlock_command_t *posted_pending = NULL;
+
+#ifdef VICE_MAINLOCK_DEBUG
+/*
+ * Histograms of how long the UI waits for the main lock and how long it
+ * holds it. Bucket n counts times below 16 << (2 * n) microseconds, the
+ * last bucket everything above. Logged on shutdown.
+ */
+#define MAINLOCK_HISTOGRAM_SIZE 8
+
+static unsigned long mainlock_wait_histogram[MAINLOCK_HISTOGRAM_SIZE];
+static unsigned long mainlock_hold_histogram[MAINLOCK_HISTOGRAM_SIZE];
+static unsigned long mainlock_posted_count;
+static tick_t mainlock_obtained_tick;
+
+static void mainlock_histogram_add(unsigned long *histogram, tick_t ticks)
+{
+    uint32_t micro = TICK_TO_MICRO(ticks);
+    int i;
+
+    for (i = 0; i < MAINLOCK_HISTOGRAM_SIZE - 1; i++) {
+        if (micro < (16U << (2 * i))) {
+            break;
+        }
+    }
+    histogram[i]++;
+}
+
+static void mainlock_histogram_log(const char *name, unsigned long *histogram)
+{
+    int i;
+
+    for (i = 0; i < MAINLOCK_HISTOGRAM_SIZE; i++) {
+        if (i < MAINLOCK_HISTOGRAM_SIZE - 1) {
+            log_message(LOG_DEFAULT, "mainlock %s < %7u us: %lu",
+                        name, 16U << (2 * i), histogram[i]);
+        } else {
+            log_message(LOG_DEFAULT, "mainlock %s longer    : %lu",
+                        name, histogram[i]);
+        }
+    }
+}
+#endif
+
 void mainlock_init(void)
 {
 }
 
 
+/* Run the commands picked up by mainlock_yield_begin(), VICE thread only. */
+static void run_posted_commands(void)
+{
+    mainlock_command_t *command;
+
+    while (posted_pending != NULL) {
+        command = posted_pending;
+        posted_pending = command->next;
+
+        command->callback(command->param);
+        lib_free(command);
+    }
+}
+
+
+/* Drop commands that will never run, VICE thread with internal_lock held. */
+static void free_posted_commands(void)
+{
+    mainlock_command_t *command;
+
+    while (posted_pending != NULL) {
+        command = posted_pending;
+        posted_pending = command->next;
+        lib_free(command);
+    }
+    while (posted_head != NULL) {
+        command = posted_head;
+        posted_head = command->next;
+        lib_free(command);
+    }
+    posted_tail = NULL;
+}
+
+
 void mainlock_set_vice_thread(void)
 {
     pthread_mutex_lock(&internal_lock);
@@ -98,6 +193,9 @@ static void consider_exit(void)
         /* Setting this lets the UI thread know not to wait for signals in future mainlock_obtain() calls */
         vice_thread_is_running = false;
 
+        /* From here on mainlock_post() runs commands itself */
+        free_posted_commands();
+
         if (ui_is_waiting) {
             /* Wake up the UI thread, otherwise it will be waiting forever */
             pthread_cond_signal(&ui_waiting_cond);
@@ -137,6 +235,12 @@ void mainlock_initiate_shutdown(void)
 
     log_message(LOG_DEFAULT, "VICE thread initiating shutdown");
 
+#ifdef VICE_MAINLOCK_DEBUG
+    mainlock_histogram_log("wait", mainlock_wait_histogram);
+    mainlock_histogram_log("hold", mainlock_hold_histogram);
+    log_message(LOG_DEFAULT, "mainlock posted commands: %lu", mainlock_posted_count);
+#endif
+
     /* If called on the vice thread itself, run the exit code immediately */
     if (pthread_equal(pthread_self(), vice_thread)) {
         consider_exit();
@@ -173,6 +277,13 @@ void mainlock_yield_begin(void)
         /* Block until the UI has the main lock */
         pthread_cond_wait(&ui_has_lock_cond, &internal_lock);
     }
+
+    /* Take any posted commands, they run once we have the main lock again */
+    if (posted_head != NULL && posted_pending == NULL) {
+        posted_pending = posted_head;
+        posted_head = NULL;
+        posted_tail = NULL;
+    }
     pthread_mutex_unlock(&internal_lock);
 }
 
@@ -185,6 +296,8 @@ void mainlock_yield_end(void)
 
     /* After the UI *might* have had the lock, check if we should exit. */
     consider_exit();
+
+    run_posted_commands();
 }
 
 /** \brief Release the mainlock and sleep
@@ -200,6 +313,10 @@ void mainlock_yield_and_sleep(tick_t ticks)
 
 void mainlock_obtain(void)
 {
+#ifdef VICE_MAINLOCK_DEBUG
+    tick_t wait_start;
+#endif
+
 #ifdef DEBUG
     if (pthread_equal(pthread_self(), vice_thread)) {
         /*
@@ -227,6 +344,10 @@ void mainlock_obtain(void)
         return;
     }
 
+#ifdef VICE_MAINLOCK_DEBUG
+    wait_start = tick_now();
+#endif
+
     pthread_mutex_lock(&internal_lock);
 
     if (vice_thread_is_running) {
@@ -243,6 +364,62 @@ void mainlock_obtain(void)
 
     /* Let the VICE thread know we have the mainlock now */
     pthread_cond_signal(&ui_has_lock_cond);
+
+#ifdef VICE_MAINLOCK_DEBUG
+    mainlock_obtained_tick = tick_now();
+    mainlock_histogram_add(mainlock_wait_histogram, mainlock_obtained_tick - wait_start);
+#endif
+}
+
+
+/** \brief Run \a callback(\a param) on the VICE thread without stopping it
+ *
+ * Meant for fire-and-forget UI requests (toggles, key presses and the like)
+ * that don't need a result: instead of waiting for the VICE thread to hand
+ * over the main lock, the command is queued and executed at the next point
+ * the VICE thread yields, with the main lock held.
+ *
+ * Commands run in the order they were posted. Called on the VICE thread, or
+ * once that thread is gone, the command is executed immediately.
+ *
+ * \param[in]   callback    function to run
+ * \param[in]   param       argument for \a callback
+ */
+void mainlock_post(mainlock_callback_t callback, void *param)
+{
+    mainlock_command_t *command;
+
+    if (pthread_equal(pthread_self(), vice_thread)) {
+        callback(param);
+        return;
+    }
+
+    command = lib_malloc(sizeof *command);
+    command->callback = callback;
+    command->param = param;
+    command->next = NULL;
+
+    pthread_mutex_lock(&internal_lock);
+    if (vice_thread_is_running) {
+        if (posted_tail != NULL) {
+            posted_tail->next = command;
+        } else {
+            posted_head = command;
+        }
+        posted_tail = command;
+#ifdef VICE_MAINLOCK_DEBUG
+        mainlock_posted_count++;
+#endif
+        pthread_mutex_unlock(&internal_lock);
+        return;
+    }
+    pthread_mutex_unlock(&internal_lock);
+
+    /* No VICE thread to pick it up, run it under the lock right here */
+    lib_free(command);
+    mainlock_obtain();
+    callback(param);
+    mainlock_release();
 }
 
 
@@ -262,6 +439,12 @@ void mainlock_release(void)
     }
 #endif
 
+#ifdef VICE_MAINLOCK_DEBUG
+    if (main_lock_obtain_depth == 1) {
+        mainlock_histogram_add(mainlock_hold_histogram, tick_now() - mainlock_obtained_tick);
+    }
+#endif
+
     pthread_mutex_unlock(&main_lock);
 
     main_lock_obtain_depth--;
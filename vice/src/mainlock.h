@@ -32,6 +32,9 @@
 
 #include "archdep.h"
 
+/** \brief Function run on the VICE thread by mainlock_post() */
+typedef void (*mainlock_callback_t)(void *param);
+
 #ifdef USE_VICE_THREAD
 
 #include <pthread.h>
@@ -50,6 +53,8 @@ void mainlock_yield_end(void);
 void mainlock_obtain(void);
 void mainlock_release(void);
 
+void mainlock_post(mainlock_callback_t callback, void *param);
+
 bool mainlock_is_vice_thread(void);
 
 #define mainlock_assert_is_not_vice_thread() assert(!mainlock_is_vice_thread())
@@ -65,6 +70,8 @@ bool mainlock_is_vice_thread(void);
 #define mainlock_obtain()
 #define mainlock_release()
 
+#define mainlock_post(callback, param) (callback)(param)
+
 #define mainlock_assert_is_not_vice_thread()
 #define mainlock_assert_is_vice_thread()
 
@@ -584,6 +584,10 @@ void maincpu_set_carry(int c) {
     MOS6510_REGS_SET_CARRY(&maincpu_regs, c);
 }
 
+void maincpu_set_overflow(int v) {
+    MOS6510_REGS_SET_OVERFLOW(&maincpu_regs, v);
+}
+
 void maincpu_set_interrupt(int i) {
     MOS6510_REGS_SET_INTERRUPT(&maincpu_regs, i);
 }
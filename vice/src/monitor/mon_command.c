@@ -285,6 +285,13 @@ static const mon_cmds_t mon_cmd_array[] = {
       NO_FILENAME_ARG
     },
 
+    { "disass_save", "dsave",
+      "\"<filename>\" <address1> <address2>",
+      "Disassemble the memory from address1 to address2 into the specified\n"
+      "file, including labels.  Memory is read without side effects.",
+      FILENAME_ARG
+    },
+
     { "fill", "f",
       "<address_range> <data_list>",
       "Fill memory in the specified address range with the data in\n"
@@ -33,8 +33,10 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "archdep.h"
 #include "asm.h"
 #include "console.h"
+#include "lib.h"
 #include "log.h"
 #include "mon_disassemble.h"
 #include "mon_util.h"
@@ -1615,3 +1617,69 @@ void mon_disassemble_lines(MON_ADDR start_addr, MON_ADDR end_addr)
         }
     }
 }
+
+/* Disassemble a range into a file.  The whole range is fetched up front
+   without side effects, and the lines go straight to a buffered stdio file
+   instead of through the monitor console, which makes it usable for
+   dumping large areas for offline analysis.  */
+void mon_disassemble_to_file(const char *filename, MON_ADDR start_addr, MON_ADDR end_addr)
+{
+    monitor_cpu_type_t *monitor_cpu;
+    MEMSPACE mem;
+    uint16_t loc;
+    long len, i;
+    unsigned opc_size;
+    uint8_t *buffer;
+    const char *dis_inst;
+    char *label;
+    FILE *fp;
+    int failed;
+
+    len = mon_evaluate_address_range(&start_addr, &end_addr, TRUE, -1);
+    if (len <= 0) {
+        mon_out("Invalid range.\n");
+        return;
+    }
+
+    fp = fopen(filename, MODE_WRITE_TEXT);
+    if (fp == NULL) {
+        mon_out("Cannot open %s.\n", filename);
+        return;
+    }
+
+    mem = addr_memspace(start_addr);
+    loc = addr_location(start_addr);
+    monitor_cpu = monitor_cpu_for_memspace[mem];
+
+    /* fetch a few extra bytes for the operands of the last instruction */
+    buffer = lib_malloc(len + 4);
+    for (i = 0; i < len + 4; i++) {
+        buffer[i] = mon_get_mem_val_nosfx(mem, (uint16_t)(loc + i));
+    }
+
+    for (i = 0; i < len; i += opc_size) {
+        label = mon_symbol_table_lookup_name(mem, (uint16_t)(loc + i));
+        if (label) {
+            fprintf(fp, ".%s:%04x   %s:\n", mon_memspace_string[mem],
+                    (unsigned int)(uint16_t)(loc + i), label);
+        }
+        dis_inst = mon_disassemble_to_string_internal(mem, (uint16_t)(loc + i), &buffer[i],
+                                                      1, &opc_size, monitor_cpu);
+        fprintf(fp, ".%s:%04x  %s\n", mon_memspace_string[mem],
+                (unsigned int)(uint16_t)(loc + i), dis_inst);
+        if (opc_size == 0) {
+            opc_size = 1;
+        }
+    }
+
+    lib_free(buffer);
+
+    failed = ferror(fp);
+    if (fclose(fp) != 0 || failed) {
+        mon_out("Saving for `%s' failed.\n", filename);
+        return;
+    }
+
+    mon_out("Saving disassembly `%s' from $%04x to $%04x\n",
+            filename, addr_location(start_addr), addr_location(end_addr));
+}
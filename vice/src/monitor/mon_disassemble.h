@@ -42,4 +42,6 @@ extern void mon_disassemble_lines(MON_ADDR start_addr, MON_ADDR end_addr);
 
 extern unsigned mon_disassemble_instr(MON_ADDR addr, int *line_count);
 
+extern void mon_disassemble_to_file(const char *filename, MON_ADDR start_addr, MON_ADDR end_addr);
+
 #endif
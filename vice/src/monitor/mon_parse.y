@@ -131,7 +131,7 @@ extern int cur_len, last_len;
 %token CMD_GOTO CMD_REGISTERS CMD_READSPACE CMD_WRITESPACE CMD_RADIX
 %token CMD_MEM_DISPLAY CMD_BREAK CMD_TRACE CMD_IO CMD_BRMON CMD_COMPARE
 %token CMD_DUMP CMD_UNDUMP CMD_EXIT CMD_DELETE CMD_CONDITION CMD_COMMAND
-%token CMD_ASSEMBLE CMD_DISASSEMBLE CMD_NEXT CMD_STEP CMD_PRINT CMD_DEVICE
+%token CMD_ASSEMBLE CMD_DISASSEMBLE CMD_DISASSEMBLE_SAVE CMD_NEXT CMD_STEP CMD_PRINT CMD_DEVICE
 %token CMD_HELP CMD_WATCH CMD_DISK CMD_QUIT CMD_CHDIR CMD_BANK
 %token CMD_LOAD_LABELS CMD_SAVE_LABELS CMD_ADD_LABEL CMD_DEL_LABEL CMD_SHOW_LABELS CMD_CLEAR_LABELS
 %token CMD_RECORD CMD_MON_STOP CMD_PLAYBACK CMD_CHAR_DISPLAY CMD_SPRITE_DISPLAY
@@ -339,6 +339,10 @@ asm_rules: CMD_ASSEMBLE address
            { mon_disassemble_lines($2[0], $2[1]); }
          | CMD_DISASSEMBLE end_cmd
            { mon_disassemble_lines(BAD_ADDR, BAD_ADDR); }
+         | CMD_DISASSEMBLE_SAVE filename address_range end_cmd
+           { mon_disassemble_to_file($2, $3[0], $3[1]); }
+         | CMD_DISASSEMBLE_SAVE filename error
+           { return ERR_EXPECT_ADDRESS; }
          ;
 
 memory_rules: CMD_MOVE address_range opt_sep address end_cmd
@@ -109,8 +109,8 @@ static int init_break_address = -1;
 
 #define MAX_LABEL_LEN 255
 #define MAX_MEMSPACE_NAME_LEN 10
-#define HASH_ARRAY_SIZE 256
-#define HASH_ADDR(x) ((x) % 0xff)
+#define HASH_ARRAY_SIZE 1024
+#define HASH_ADDR(x) ((x) & (HASH_ARRAY_SIZE - 1))
 #define OP_JSR 0x20
 #define OP_RTI 0x40
 #define OP_RTS 0x60
@@ -138,6 +138,7 @@ typedef struct symbol_entry symbol_entry_t;
 
 struct symbol_table {
     symbol_entry_t *name_list;
+    symbol_entry_t *name_hash_table[HASH_ARRAY_SIZE];
     symbol_entry_t *addr_hash_table[HASH_ARRAY_SIZE];
 };
 typedef struct symbol_table symbol_table_t;
@@ -211,6 +212,9 @@ static int playback_fp_stack_size_max = 0;
 /* if true, control returns to emulator after the last script completes */
 static bool playback_exit_after_all_playback = false;
 
+/* number of labels added by the current playback file without the parser */
+static int playback_label_count = 0;
+
 static void playback_end_file(void);
 
 static void monitor_close(bool check_exit);
@@ -1471,6 +1475,7 @@ void monitor_init(monitor_interface_t *maincpu_interface_init,
         monitor_mask[i] = MI_NONE;
         monitor_labels[i].name_list = NULL;
         for (j = 0; j < HASH_ARRAY_SIZE; j++) {
+            monitor_labels[i].name_hash_table[j] = NULL;
             monitor_labels[i].addr_hash_table[j] = NULL;
         }
     }
@@ -2130,6 +2135,10 @@ static void playback_end_file(void)
 
     playback_fp_stack_size--;
 
+    if (playback_label_count > 0) {
+        log_message(LOG_DEFAULT, "Added %d labels from monitor command playback file.", playback_label_count);
+        playback_label_count = 0;
+    }
     log_message(LOG_DEFAULT, "Closed monitor command playback file: %s", playback_filename_stack[playback_fp_stack_size]);
     lib_free(playback_filename_stack[playback_fp_stack_size]);
 
@@ -2152,6 +2161,88 @@ static void playback_end_file(void)
     }
 }
 
+/* Label files (as written by save_labels, or the VICE label output of
+   assemblers like ACME and KickAssembler) can have tens of thousands of
+   "al" lines.  Handle the plain "al [<memspace>:]<address> <label>" form
+   directly instead of running each line through the command parser and
+   the log; anything else is left to the parser.  */
+static bool playback_add_label(const char *line)
+{
+    MEMSPACE mem = e_default_space;
+    const char *p = line;
+    const char *label;
+    unsigned long loc;
+    char *end;
+    char *name;
+    int i;
+
+    if (strncmp(p, "al ", 3) == 0) {
+        p += 3;
+    } else if (strncmp(p, "add_label ", 10) == 0) {
+        p += 10;
+    } else {
+        return false;
+    }
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+
+    /* optional memspace */
+    if ((*p == 'c' || *p == 'C') && p[1] == ':') {
+        mem = e_comp_space;
+        p += 2;
+    } else {
+        for (i = e_disk8_space; i < NUM_MEMSPACES; i++) {
+            size_t len = strlen(mon_memspace_string[i]);
+
+            if (strncmp(p, mon_memspace_string[i], len) == 0 && p[len] == ':') {
+                mem = i;
+                p += len + 1;
+                break;
+            }
+        }
+    }
+
+    /* address, plain numbers are only hex if that is the default radix */
+    if (*p == '$') {
+        p++;
+    } else if (default_radix != e_hexadecimal) {
+        return false;
+    }
+    if (!isxdigit((unsigned char)*p)) {
+        return false;
+    }
+    loc = strtoul(p, &end, 16);
+    if (loc > 0xffff || (*end != ' ' && *end != '\t')) {
+        return false;
+    }
+    p = end;
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+
+    /* label, same characters as accepted by the lexer */
+    label = p;
+    if (*p++ != '.' || *p == '\0' || !(isalpha((unsigned char)*p) || strchr("_@?:", *p))) {
+        return false;
+    }
+    while (*p && (isalnum((unsigned char)*p) || strchr("_@?:.", *p))) {
+        p++;
+    }
+    if (*p != '\0') {
+        return false;
+    }
+
+    name = lib_malloc(p - label + 1);
+    memcpy(name, label, p - label);
+    name[p - label] = '\0';
+
+    mon_add_name_to_symbol_table(new_addr(mem, (unsigned int)loc), name);
+    playback_label_count++;
+
+    return true;
+}
+
 static void playback_next_command(void)
 {
     char line[1024];
@@ -2170,6 +2261,11 @@ static void playback_next_command(void)
     line[strlen(line) - 1] = '\0';
     command = lib_strdup_trimmed(line);
 
+    if (playback_add_label(command)) {
+        lib_free(command);
+        return;
+    }
+
     log_message(LOG_DEFAULT, "Monitor playback command: %s", command);
     parse_and_execute_line(command);
 
@@ -2180,6 +2276,16 @@ static void playback_next_command(void)
 /* *** SYMBOL TABLE *** */
 
 
+static unsigned int hash_name(const char *name)
+{
+    unsigned int hash = 0;
+
+    while (*name) {
+        hash = hash * 31 + (unsigned char)*name++;
+    }
+    return hash & (HASH_ARRAY_SIZE - 1);
+}
+
 static void free_symbol_table(MEMSPACE mem)
 {
     symbol_entry_t *sym_ptr, *temp;
@@ -2194,6 +2300,17 @@ static void free_symbol_table(MEMSPACE mem)
         lib_free(temp);
     }
 
+    /* Remove name hash table */
+    for (i = 0; i < HASH_ARRAY_SIZE; i++) {
+        sym_ptr = monitor_labels[mem].name_hash_table[i];
+        while (sym_ptr) {
+            /* Name memory is freed below. */
+            temp = sym_ptr;
+            sym_ptr = sym_ptr->next;
+            lib_free(temp);
+        }
+    }
+
     /* Remove address hash table */
     for (i = 0; i < HASH_ARRAY_SIZE; i++) {
         sym_ptr = monitor_labels[mem].addr_hash_table[i];
@@ -2240,7 +2357,7 @@ int mon_symbol_table_lookup_addr(MEMSPACE mem, char *name)
         return mon_register_name_to_value(mem, &name[1]);
     }
 
-    sym_ptr = monitor_labels[mem].name_list;
+    sym_ptr = monitor_labels[mem].name_hash_table[hash_name(name)];
     while (sym_ptr) {
         if (strcmp(sym_ptr->name, name) == 0) {
             return sym_ptr->addr;
@@ -2301,6 +2418,14 @@ void mon_add_name_to_symbol_table(MON_ADDR addr, char *name)
     sym_ptr->next = monitor_labels[mem].name_list;
     monitor_labels[mem].name_list = sym_ptr;
 
+    /* Add name to hash table */
+    sym_ptr = lib_malloc(sizeof(symbol_entry_t));
+    sym_ptr->name = name;
+    sym_ptr->addr = loc;
+
+    sym_ptr->next = monitor_labels[mem].name_hash_table[hash_name(name)];
+    monitor_labels[mem].name_hash_table[hash_name(name)] = sym_ptr;
+
     /* Add address to hash table */
     sym_ptr = lib_malloc(sizeof(symbol_entry_t));
     sym_ptr->name = name;
@@ -2349,6 +2474,24 @@ void mon_remove_name_from_symbol_table(MEMSPACE mem, char *name)
         sym_ptr = sym_ptr->next;
     }
 
+    /* Remove entry in name hash table */
+    sym_ptr = monitor_labels[mem].name_hash_table[hash_name(name)];
+    prev_ptr = NULL;
+    while (sym_ptr) {
+        if (strcmp(sym_ptr->name, name) == 0) {
+            /* Name memory is freed below. */
+            if (prev_ptr) {
+                prev_ptr->next = sym_ptr->next;
+            } else {
+                monitor_labels[mem].name_hash_table[hash_name(name)] = sym_ptr->next;
+            }
+            lib_free(sym_ptr);
+            break;
+        }
+        prev_ptr = sym_ptr;
+        sym_ptr = sym_ptr->next;
+    }
+
     /* Remove entry in address hash table */
     sym_ptr = monitor_labels[mem].addr_hash_table[HASH_ADDR(addr)];
     prev_ptr = NULL;
@@ -2395,6 +2538,7 @@ void mon_clear_symbol_table(MEMSPACE mem)
     monitor_labels[mem].name_list = NULL;
 
     for (i = 0; i < HASH_ARRAY_SIZE; i++) {
+        monitor_labels[mem].name_hash_table[i] = NULL;
         monitor_labels[mem].addr_hash_table[i] = NULL;
     }
 }
@@ -88,6 +88,14 @@ static int network_control;
 static int frame_buffer_full;
 static int current_frame, frame_to_play;
 static event_list_state_t *frame_event_list = NULL;
+
+/* buffers for the event lists exchanged every frame; they only grow and
+   are kept until the frame event lists are freed */
+static uint8_t *frame_send_buf = NULL;
+static unsigned int frame_send_buf_size = 0;
+static uint8_t *frame_recv_buf = NULL;
+static unsigned int frame_recv_buf_size = 0;
+
 static char *snapshotfilename;
 
 static int set_server_name(const char *val, void *param)
@@ -246,6 +254,12 @@ static void network_free_frame_event_list(void)
         lib_free(frame_event_list);
         frame_event_list = NULL;
     }
+    lib_free(frame_send_buf);
+    frame_send_buf = NULL;
+    frame_send_buf_size = 0;
+    lib_free(frame_recv_buf);
+    frame_recv_buf = NULL;
+    frame_recv_buf_size = 0;
     event_destroy_image_list();
 }
 
@@ -284,7 +298,10 @@ static void network_prepare_next_frame(void)
     interrupt_maincpu_trigger_trap(network_event_record_sync_test, (void *)0);
 }
 
+/* serialize list into *buf, which is (re)allocated if it is smaller than
+   *buf_size bytes. returns the length of the data. */
 static unsigned int network_create_event_buffer(uint8_t **buf,
+                                                unsigned int *buf_size,
                                                 event_list_state_t *list)
 {
     int size;
@@ -311,7 +328,10 @@ static unsigned int network_create_event_buffer(uint8_t **buf,
 
     size = num_of_events * 3 * sizeof(uint32_t) + data_len;
 
-    *buf = lib_malloc(size);
+    if ((unsigned int)size > *buf_size) {
+        *buf = lib_realloc(*buf, size);
+        *buf_size = size;
+    }
 
     /* fill the buffer with the events */
     current_event = list->base;
@@ -329,16 +349,15 @@ static unsigned int network_create_event_buffer(uint8_t **buf,
     return size;
 }
 
-static event_list_state_t *network_create_event_list(uint8_t *remote_event_buffer)
+static void network_create_event_list(event_list_state_t *list,
+                                      uint8_t *remote_event_buffer)
 {
-    event_list_state_t *list;
     unsigned int type, size;
     uint8_t *data = NULL;
     uint8_t *bufptr = remote_event_buffer;
 
     DBGT(("network_create_event_list entry: %p", bufptr));
 
-    list = lib_malloc(sizeof(event_list_state_t));
     event_register_event_list(list);
 
     if (bufptr == NULL) {
@@ -356,8 +375,6 @@ static event_list_state_t *network_create_event_list(uint8_t *remote_event_buffe
         } while (type != EVENT_LIST_END);
     }
     DBGT(("network_create_event_list exit: %p", bufptr));
-
-    return list;
 }
 
 static int network_recv_buffer(vice_network_socket_t * s, uint8_t *buf, int len)
@@ -490,6 +507,7 @@ static void network_server_connect_trap(uint16_t addr, void *data)
     FILE *f;
     uint8_t *buf;
     off_t buf_size;
+    unsigned int buf_alloc;
     uint8_t send_size4[4];
     int i;
     event_list_state_t settings_list;
@@ -535,7 +553,9 @@ static void network_server_connect_trap(uint16_t addr, void *data)
         event_register_event_list(&settings_list);
         resources_get_event_safe_list(&settings_list);
 
-        buf_size = (size_t)network_create_event_buffer(&buf, &(settings_list));
+        buf = NULL;
+        buf_alloc = 0;
+        buf_size = (size_t)network_create_event_buffer(&buf, &buf_alloc, &(settings_list));
         util_int_to_le_buf4(send_size4, (int)buf_size);
 
         if ((i = network_send_buffer(network_socket, send_size4, 4) < 0)) {
@@ -568,7 +588,7 @@ static void network_client_connect_trap(uint16_t addr, void *data)
     uint8_t *buf;
     size_t buf_size;
     uint8_t recv_buf4[4];
-    event_list_state_t *settings_list;
+    event_list_state_t settings_list;
 
     DBG(("network_client_connect_trap"));
 
@@ -592,13 +612,12 @@ static void network_client_connect_trap(uint16_t addr, void *data)
         return;
     }
 
-    settings_list = network_create_event_list(buf);
+    network_create_event_list(&settings_list, buf);
     lib_free(buf);
 
-    event_playback_event_list(settings_list);
+    event_playback_event_list(&settings_list);
 
-    event_clear_list(settings_list);
-    lib_free(settings_list);
+    event_clear_list(&settings_list);
 
     /* read the snapshot */
     if (machine_read_snapshot(snapshotfilename, 0) != 0) {
@@ -853,7 +872,6 @@ long t1, t2, t3, t4;
 
 static void network_hook_connected_send(void)
 {
-    uint8_t *local_event_buf = NULL;
     unsigned int send_len;
     uint8_t send_len4[4];
 
@@ -861,7 +879,8 @@ static void network_hook_connected_send(void)
 
     /* create and send current event buffer */
     network_event_record(EVENT_LIST_END, NULL, 0);
-    send_len = network_create_event_buffer(&local_event_buf, &(frame_event_list[current_frame]));
+    send_len = network_create_event_buffer(&frame_send_buf, &frame_send_buf_size,
+                                           &(frame_event_list[current_frame]));
 
 #ifdef NETWORK_TRAFFIC_DEBUG
     t1 = tick_now();
@@ -871,23 +890,20 @@ static void network_hook_connected_send(void)
     if (network_send_buffer(network_socket, send_len4, 4) < 0) {
         ui_display_statustext("Remote host disconnected.", 1);
         network_disconnect();
-    } else if (network_send_buffer(network_socket, local_event_buf, send_len) < 0) {
+    } else if (network_send_buffer(network_socket, frame_send_buf, send_len) < 0) {
         ui_display_statustext("Remote host disconnected.", 1);
         network_disconnect();
     }
 #ifdef NETWORK_TRAFFIC_DEBUG
     t2 = tick_now_after(t1);
 #endif
-
-    lib_free(local_event_buf);
 }
 
 static void network_hook_connected_receive(void)
 {
-    uint8_t *remote_event_buf = NULL;
     unsigned int recv_len;
     uint8_t recv_len4[4];
-    event_list_state_t *remote_event_list;
+    event_list_state_t remote_event_list;
     event_list_state_t *client_event_list, *server_event_list;
 
     DBGT(("network_hook_connected_receive"));
@@ -919,11 +935,13 @@ static void network_hook_connected_receive(void)
             ui_display_statustext("", 0);
         }
 
-        remote_event_buf = lib_malloc(recv_len);
+        if (recv_len > frame_recv_buf_size) {
+            frame_recv_buf = lib_realloc(frame_recv_buf, recv_len);
+            frame_recv_buf_size = recv_len;
+        }
 
-        if (network_recv_buffer(network_socket, remote_event_buf,
+        if (network_recv_buffer(network_socket, frame_recv_buf,
                                 recv_len) < 0) {
-            lib_free(remote_event_buf);
             return;
         }
 
@@ -931,14 +949,13 @@ static void network_hook_connected_receive(void)
         t3 = tick_now_after(t2);
 #endif
 
-        remote_event_list = network_create_event_list(remote_event_buf);
-        lib_free(remote_event_buf);
+        network_create_event_list(&remote_event_list, frame_recv_buf);
 
         if (network_mode == NETWORK_SERVER_CONNECTED) {
-            client_event_list = remote_event_list;
+            client_event_list = &remote_event_list;
             server_event_list = &(frame_event_list[frame_to_play]);
         } else {
-            server_event_list = remote_event_list;
+            server_event_list = &remote_event_list;
             client_event_list = &(frame_event_list[frame_to_play]);
         }
 
@@ -962,8 +979,7 @@ static void network_hook_connected_receive(void)
         event_playback_event_list(server_event_list);
         event_playback_event_list(client_event_list);
 
-        event_clear_list(remote_event_list);
-        lib_free(remote_event_list);
+        event_clear_list(&remote_event_list);
     }
     network_prepare_next_frame();
 #ifdef NETWORK_TRAFFIC_DEBUG
@@ -36,6 +36,7 @@
 #include <stdio.h>
 
 #include "autostart.h"
+#include "crtc.h"
 #include "kbdbuf.h"
 #include "log.h"
 #include "mem.h"
@@ -584,6 +585,7 @@ static int mem_read_rom_snapshot_module(snapshot_t *s)
         }
 
         petrom_convert_chargen(mem_chargen_rom);
+        crtc_chargen_changed();
     }
 
     log_warning(pet_snapshot_log, "Dumped Romset files and saved settings will "
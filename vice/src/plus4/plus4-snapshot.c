@@ -83,6 +83,7 @@ int plus4_snapshot_write(const char *name, int save_roms, int save_disks,
         || fsdrive_snapshot_write_module(s) < 0
         || ted_snapshot_write_module(s) < 0
         || event_snapshot_write_module(s, event_mode) < 0
+        || machine_common_snapshot_write_module(s) < 0
         || tapeport_snapshot_write_module(s, save_disks) < 0
         || keyboard_snapshot_write_module(s) < 0
         || joyport_snapshot_write_module(s, JOYPORT_1) < 0
@@ -125,6 +126,7 @@ int plus4_snapshot_read(const char *name, int event_mode)
         || fsdrive_snapshot_read_module(s) < 0
         || ted_snapshot_read_module(s) < 0
         || event_snapshot_read_module(s, event_mode) < 0
+        || machine_common_snapshot_read_module(s) < 0
         || tapeport_snapshot_read_module(s) < 0
         || keyboard_snapshot_read_module(s) < 0
         || joyport_snapshot_read_module(s, JOYPORT_1) < 0
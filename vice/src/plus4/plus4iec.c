@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "debug.h"
 #include "drive.h"
 #include "maincpu.h"
 #include "iecbus.h"
@@ -66,6 +67,10 @@ void iec_drive_write(uint8_t data, unsigned int dnr)
                                   & 0x80));
     iecbus.drv_data[dnr + 8] = data;
     iec_update_ports();
+
+    if (debug.bustrace) {
+        iec_drive_bus_trace(&iecbus, dnr);
+    }
 }
 
 uint8_t iec_drive_read(unsigned int dnr)
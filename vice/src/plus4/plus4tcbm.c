@@ -26,6 +26,7 @@
 
 #include "vice.h"
 
+#include "debug.h"
 #include "drive.h"
 #include "drivetypes.h"
 #include "iecdrive.h"
@@ -55,19 +56,45 @@ uint8_t tpid_outputa[2], tpid_outputb[2], tpid_outputc[2];
 
 /*-----------------------------------------------------------------------*/
 
+static void tcbm_trace(unsigned int dnr, unsigned int side)
+{
+    uint32_t state;
+
+    if (side == DEBUG_BUSTRACE_COMPUTER) {
+        state = plus4tcbm_outputa[dnr] | (plus4tcbm_outputb[dnr] << 8)
+                | (plus4tcbm_outputc[dnr] << 16);
+    } else {
+        state = tpid_outputa[dnr] | (tpid_outputb[dnr] << 8)
+                | (tpid_outputc[dnr] << 16);
+    }
+    debug_bustrace(DEBUG_BUSTRACE_TCBM, dnr, side, state);
+}
+
 void plus4tcbm_update_pa(uint8_t byte, unsigned int dnr)
 {
     tpid_outputa[dnr] = byte;
+
+    if (debug.bustrace) {
+        tcbm_trace(dnr, DEBUG_BUSTRACE_DRIVE);
+    }
 }
 
 void plus4tcbm_update_pb(uint8_t byte, unsigned int dnr)
 {
     tpid_outputb[dnr] = byte;
+
+    if (debug.bustrace) {
+        tcbm_trace(dnr, DEBUG_BUSTRACE_DRIVE);
+    }
 }
 
 void plus4tcbm_update_pc(uint8_t byte, unsigned int dnr)
 {
     tpid_outputc[dnr] = byte;
+
+    if (debug.bustrace) {
+        tcbm_trace(dnr, DEBUG_BUSTRACE_DRIVE);
+    }
 }
 
 /*-----------------------------------------------------------------------*/
@@ -109,6 +136,10 @@ inline static void store_pa(unsigned int dnr)
               tiatcbm[dnr].dataa, tiatcbm[dnr].ddra);
 #endif
     plus4tcbm_outputa[dnr] = tiatcbm[dnr].dataa | ~tiatcbm[dnr].ddra;
+
+    if (debug.bustrace) {
+        tcbm_trace(dnr, DEBUG_BUSTRACE_COMPUTER);
+    }
 }
 
 inline static void store_pb(unsigned int dnr)
@@ -118,6 +149,10 @@ inline static void store_pb(unsigned int dnr)
               tiatcbm[dnr].datab, tiatcbm[dnr].ddrb);
 #endif
     plus4tcbm_outputb[dnr] = tiatcbm[dnr].datab | ~tiatcbm[dnr].ddrb;
+
+    if (debug.bustrace) {
+        tcbm_trace(dnr, DEBUG_BUSTRACE_COMPUTER);
+    }
 }
 
 inline static void store_pc(unsigned int dnr)
@@ -128,6 +163,10 @@ inline static void store_pc(unsigned int dnr)
 #endif
 
     plus4tcbm_outputc[dnr] = tiatcbm[dnr].datac | ~tiatcbm[dnr].ddrc;
+
+    if (debug.bustrace) {
+        tcbm_trace(dnr, DEBUG_BUSTRACE_COMPUTER);
+    }
 }
 
 /*-----------------------------------------------------------------------*/
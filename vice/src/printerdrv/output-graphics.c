@@ -51,6 +51,7 @@ struct output_gfx_s {
     unsigned int isopen;
     unsigned int line_pos;
     unsigned int line_no;
+    unsigned int line_dirty;    /* line holds anything but white pixels */
 };
 typedef struct output_gfx_s output_gfx_t;
 
@@ -90,6 +91,33 @@ static void output_graphics_line_data(screenshot_t *screenshot, uint8_t *data,
 
     line_base = output_gfx[current_prnr].line;
 
+    /* most lines of a page are empty, don't convert those pixel by pixel */
+    if (!output_gfx[current_prnr].line_dirty) {
+        color = output_pixel_to_palette_index(OUTPUT_PIXEL_WHITE);
+        switch (mode) {
+            case SCREENSHOT_MODE_PALETTE:
+                memset(data, (int)color, screenshot->width);
+                return;
+            case SCREENSHOT_MODE_RGB32:
+                for (i = 0; i < screenshot->width; i++) {
+                    data[i * 4] = screenshot->palette->entries[color].red;
+                    data[i * 4 + 1] = screenshot->palette->entries[color].green;
+                    data[i * 4 + 2] = screenshot->palette->entries[color].blue;
+                    data[i * 4 + 3] = 0;
+                }
+                return;
+            case SCREENSHOT_MODE_RGB24:
+                for (i = 0; i < screenshot->width; i++) {
+                    data[i * 3] = screenshot->palette->entries[color].red;
+                    data[i * 3 + 1] = screenshot->palette->entries[color].green;
+                    data[i * 3 + 2] = screenshot->palette->entries[color].blue;
+                }
+                return;
+            default:
+                break;
+        }
+    }
+
     switch (mode) {
         case SCREENSHOT_MODE_PALETTE:
             for (i = 0; i < screenshot->width; i++) {
@@ -162,6 +190,7 @@ static int output_graphics_open(unsigned int prnr,
     lib_free(output_gfx[prnr].line);
     output_gfx[prnr].line = lib_malloc(output_parameter->maxcol);
     memset(output_gfx[prnr].line, OUTPUT_PIXEL_WHITE, output_parameter->maxcol);
+    output_gfx[prnr].line_dirty = 0;
 
     output_gfx[prnr].line_pos = 0;
     output_gfx[prnr].line_no = 0;
@@ -187,6 +216,7 @@ static void output_graphics_close(unsigned int prnr)
 
         /* fill rest of page with blank lines */
         memset(o->line, OUTPUT_PIXEL_WHITE, o->screenshot.width);
+        o->line_dirty = 0;
         for (i = o->line_no; i < o->screenshot.height; i++) {
             (o->gfxoutputdrv->write)(&o->screenshot);
         }
@@ -224,7 +254,10 @@ static int output_graphics_putc(unsigned int prnr, uint8_t b)
         /* write buffered line to output and clear buffer */
         current_prnr = prnr;
         (o->gfxoutputdrv->write)(&o->screenshot);
-        memset(o->line, OUTPUT_PIXEL_WHITE, o->screenshot.width);
+        if (o->line_dirty) {
+            memset(o->line, OUTPUT_PIXEL_WHITE, o->screenshot.width);
+            o->line_dirty = 0;
+        }
         o->line_pos = 0;
 
         /* check for bottom of page.  If so, close output file */
@@ -237,6 +270,9 @@ static int output_graphics_putc(unsigned int prnr, uint8_t b)
         /* store pixel in buffer */
         if (o->line_pos < o->screenshot.width) {
             o->line[o->line_pos] = b;
+            if (b != OUTPUT_PIXEL_WHITE) {
+                o->line_dirty = 1;
+            }
         }
         if (o->line_pos < o->screenshot.width - 1) {
             o->line_pos++;
@@ -277,6 +313,7 @@ void output_graphics_init(void)
         output_gfx[i].filename = NULL;
         output_gfx[i].line = NULL;
         output_gfx[i].line_pos = 0;
+        output_gfx[i].line_dirty = 0;
     }
 }
 
@@ -1423,8 +1423,11 @@ static int resource_item_isdefault(int num)
 int resources_save(const char *fname)
 {
     char *backup_name = NULL;
+    char *temp_name;
     FILE *in_file = NULL, *out_file;
     unsigned int i;
+    int write_error;
+    int result = 0;
     char *default_name = NULL;
 
     /* get name for config file */
@@ -1446,38 +1449,16 @@ int resources_save(const char *fname)
         fname = default_name;
     }
 
-    /* make a backup of an existing config, open it */
+    /* open the existing config, it is only replaced once the new one has
+       been written out completely */
     if (util_file_exists(fname) != 0) {
         /* try to open it */
         if (archdep_access(fname, ARCHDEP_ACCESS_W_OK) != 0) {
             lib_free(default_name);
             return RESERR_WRITE_PROTECTED;
         }
-        /* get backup name */
-        backup_name = archdep_make_backup_filename(fname);
-        /* if backup exists, remove it */
-        if (util_file_exists(backup_name) != 0) {
-            if (archdep_access(backup_name, ARCHDEP_ACCESS_W_OK) != 0) {
-                lib_free(backup_name);
-                lib_free(default_name);
-                return RESERR_WRITE_PROTECTED;
-            }
-            if (archdep_remove(backup_name) != 0) {
-                lib_free(backup_name);
-                lib_free(default_name);
-                return RESERR_CANNOT_REMOVE_BACKUP;
-            }
-        }
-        /* move existing config to backup */
-        if (archdep_rename(fname, backup_name) != 0) {
-            lib_free(backup_name);
-            lib_free(default_name);
-            return RESERR_CANNOT_RENAME_FILE;
-        }
-        /* open the old config */
-        in_file = fopen(backup_name, MODE_READ_TEXT);
+        in_file = fopen(fname, MODE_READ_TEXT);
         if (!in_file) {
-            lib_free(backup_name);
             lib_free(default_name);
             return RESERR_READ_ERROR;
         }
@@ -1485,19 +1466,18 @@ int resources_save(const char *fname)
 
     log_message(LOG_DEFAULT, "Writing configuration file `%s'.", fname);
 
-    out_file = fopen(fname, MODE_WRITE_TEXT);
+    temp_name = util_concat(fname, ".tmp", NULL);
+    out_file = fopen(temp_name, MODE_WRITE_TEXT);
 
     if (!out_file) {
         if (in_file != NULL) {
             fclose(in_file);
         }
-        lib_free(backup_name);
+        lib_free(temp_name);
         lib_free(default_name);
         return RESERR_CANNOT_CREATE_FILE;
     }
 
-    setbuf(out_file, NULL);
-
     /* put version tag at the top of the config file */
     fprintf(out_file, "[Version]\nConfigVersion=%s\n\n", VERSION);
 
@@ -1582,15 +1562,53 @@ int resources_save(const char *fname)
                 fprintf(out_file, "%s\n", buf);
             }
         }
+    }
+
+    write_error = ferror(out_file);
+    if (fclose(out_file) != 0 || write_error) {
+        if (in_file != NULL) {
+            fclose(in_file);
+        }
+        archdep_remove(temp_name);
+        lib_free(temp_name);
+        lib_free(default_name);
+        return RESERR_CANNOT_CREATE_FILE;
+    }
+
+    if (in_file != NULL) {
         fclose(in_file);
-        /* remove the backup */
-        archdep_remove(backup_name);
+
+        /* move the old config out of the way, rename() cannot replace an
+           existing file everywhere */
+        backup_name = archdep_make_backup_filename(fname);
+        if (util_file_exists(backup_name) != 0
+                && archdep_remove(backup_name) != 0) {
+            result = RESERR_CANNOT_REMOVE_BACKUP;
+        } else if (archdep_rename(fname, backup_name) != 0) {
+            result = RESERR_CANNOT_RENAME_FILE;
+        }
     }
 
-    fclose(out_file);
+    if (result == 0) {
+        if (archdep_rename(temp_name, fname) != 0) {
+            /* put the old config back */
+            if (backup_name != NULL) {
+                archdep_rename(backup_name, fname);
+            }
+            result = RESERR_CANNOT_RENAME_FILE;
+        } else if (backup_name != NULL) {
+            /* remove the backup */
+            archdep_remove(backup_name);
+        }
+    }
+
+    if (result != 0) {
+        archdep_remove(temp_name);
+    }
+    lib_free(temp_name);
     lib_free(backup_name);
     lib_free(default_name);
-    return 0;
+    return result;
 }
 
 /* dump ALL resources of the current machine into a file */
@@ -1607,8 +1625,6 @@ int resources_dump(const char *fname)
         return RESERR_CANNOT_CREATE_FILE;
     }
 
-    setbuf(out_file, NULL);
-
     /* Write our current configuration.  */
     fprintf(out_file, "[%s]\n", machine_id);
     for (i = 0; i < num_resources; i++) {
@@ -81,6 +81,7 @@ int scpu64_snapshot_write(const char *name, int save_roms, int save_disks, int e
         || vicii_snapshot_write_module(s) < 0
         || scpu64_glue_snapshot_write_module(s) < 0
         || event_snapshot_write_module(s, event_mode) < 0
+        || machine_common_snapshot_write_module(s) < 0
         || keyboard_snapshot_write_module(s) < 0
         || joyport_snapshot_write_module(s, JOYPORT_1) < 0
         || joyport_snapshot_write_module(s, JOYPORT_2) < 0
@@ -124,6 +125,7 @@ int scpu64_snapshot_read(const char *name, int event_mode)
         || vicii_snapshot_read_module(s) < 0
         || scpu64_glue_snapshot_read_module(s) < 0
         || event_snapshot_read_module(s, event_mode) < 0
+        || machine_common_snapshot_read_module(s) < 0
         || keyboard_snapshot_read_module(s) < 0
         || joyport_snapshot_read_module(s, JOYPORT_1) < 0
         || joyport_snapshot_read_module(s, JOYPORT_2) < 0
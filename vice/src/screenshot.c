@@ -30,18 +30,24 @@
 
 #include "vice.h"
 
+#include <ctype.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "archdep.h"
+#include "cmdline.h"
 #include "gfxoutput.h"
 #include "lib.h"
 #include "log.h"
 #include "machine.h"
+#include "machine-video.h"
 #include "palette.h"
 #include "resources.h"
 #include "screenshot.h"
 #include "uiapi.h"
+#include "util.h"
 #include "video.h"
 
 
@@ -54,6 +60,26 @@ static char *reopen_recording_drivername;
 static struct video_canvas_s *reopen_recording_canvas;
 static char *reopen_filename;
 
+/* Screen hashing for visual regression tests.  A checkpoint file holds
+   lines of "<frame> <hash>" (decimal frame, hexadecimal hash); the hash
+   log is written in the same format, so a log of a known good run can
+   be used as checkpoint file for later runs.  */
+typedef struct screenshot_hash_checkpoint_s {
+    unsigned int frame;
+    uint32_t hash;
+} screenshot_hash_checkpoint_t;
+
+static char *hash_file_name = NULL;
+static char *hash_log_name = NULL;
+static int hash_match_exit_code;
+static int hash_mismatch_exit_code;
+
+static FILE *hash_log_fd = NULL;
+static screenshot_hash_checkpoint_t *hash_checkpoints = NULL;
+static unsigned int hash_checkpoint_num = 0;
+static unsigned int hash_checkpoint_next = 0;
+static unsigned int hash_frame = 0;
+
 
 /** \brief  Initialize module
  *
@@ -82,6 +108,10 @@ void screenshot_shutdown(void)
     if (reopen_filename != NULL) {
         lib_free(reopen_filename);
     }
+    if (hash_log_fd != NULL) {
+        fclose(hash_log_fd);
+        hash_log_fd = NULL;
+    }
 }
 
 
@@ -135,8 +165,10 @@ static void screenshot_line_data(screenshot_t *screenshot, uint8_t *data,
 }
 
 /*-----------------------------------------------------------------------*/
-static int screenshot_save_core(screenshot_t *screenshot, gfxoutputdrv_t *drv,
-                                const char *filename)
+
+/* Set up the visible area and the identity color map of a screenshot
+   retrieved with machine_screenshot().  */
+static void screenshot_setup(screenshot_t *screenshot)
 {
     unsigned int i;
 
@@ -151,6 +183,12 @@ static int screenshot_save_core(screenshot_t *screenshot, gfxoutputdrv_t *drv,
     }
 
     screenshot->convert_line = screenshot_line_data;
+}
+
+static int screenshot_save_core(screenshot_t *screenshot, gfxoutputdrv_t *drv,
+                                const char *filename)
+{
+    screenshot_setup(screenshot);
 
     if (drv != NULL) {
         if (drv->save_native != NULL) {
@@ -240,10 +278,116 @@ int memmap_screenshot_save(const char *drvname, const char *filename, int x_size
 }
 #endif
 
+/*-----------------------------------------------------------------------*/
+
+/* FNV-1a, which is cheap enough to run on every frame.  */
+#define HASH_FNV_OFFSET 2166136261U
+#define HASH_FNV_PRIME  16777619U
+
+static uint32_t hash_bytes(uint32_t hash, const uint8_t *data, unsigned int len)
+{
+    while (len-- > 0) {
+        hash = (hash ^ *data++) * HASH_FNV_PRIME;
+    }
+    return hash;
+}
+
+/** \brief  Calculate a hash of the visible area of \a canvas
+ *
+ * The hash covers the size of the visible area and the palette index of
+ * every pixel in it, so it does not depend on the palette or the video
+ * renderer in use.
+ *
+ * \param[in]   canvas  video canvas
+ * \param[out]  hash    hash of the visible area
+ *
+ * \return  0 on success, -1 on error
+ */
+int screenshot_hash(struct video_canvas_s *canvas, uint32_t *hash)
+{
+    screenshot_t screenshot;
+    uint8_t size[8];
+    uint8_t *data;
+    unsigned int line;
+    uint32_t h = HASH_FNV_OFFSET;
+
+    if (machine_screenshot(&screenshot, canvas) < 0) {
+        log_error(screenshot_log, "Retrieving screen geometry failed.");
+        return -1;
+    }
+
+    screenshot_setup(&screenshot);
+
+    util_dword_to_le_buf(size, screenshot.width);
+    util_dword_to_le_buf(size + 4, screenshot.height);
+    h = hash_bytes(h, size, sizeof(size));
+
+    data = lib_malloc(screenshot.width);
+    for (line = 0; line < screenshot.height; line++) {
+        screenshot_line_data(&screenshot, data, line, SCREENSHOT_MODE_PALETTE);
+        h = hash_bytes(h, data, screenshot.width);
+    }
+    lib_free(data);
+    lib_free(screenshot.color_map);
+
+    *hash = h;
+    return 0;
+}
+
+/* Called at the end of every frame, log the hash and check it against the
+   next checkpoint.  */
+static void screenshot_hash_frame(void)
+{
+    screenshot_hash_checkpoint_t *checkpoint = NULL;
+    uint32_t hash;
+
+    if (hash_checkpoint_next < hash_checkpoint_num
+        && hash_checkpoints[hash_checkpoint_next].frame == hash_frame) {
+        checkpoint = &hash_checkpoints[hash_checkpoint_next];
+    }
+
+    if (checkpoint == NULL && hash_log_fd == NULL) {
+        return;
+    }
+
+    if (screenshot_hash(machine_video_canvas_get(0), &hash) < 0) {
+        return;
+    }
+
+    if (hash_log_fd != NULL) {
+        fprintf(hash_log_fd, "%u %08x\n", hash_frame, (unsigned int)hash);
+    }
+
+    if (checkpoint == NULL) {
+        return;
+    }
+
+    if (checkpoint->hash != hash) {
+        log_error(screenshot_log,
+                  "Screen hash mismatch at frame %u: expected %08x, got %08x.",
+                  hash_frame, (unsigned int)checkpoint->hash, (unsigned int)hash);
+        archdep_vice_exit(hash_mismatch_exit_code);
+        return;
+    }
+
+    log_message(screenshot_log, "Screen hash at frame %u matches.", hash_frame);
+
+    if (++hash_checkpoint_next == hash_checkpoint_num) {
+        log_message(screenshot_log, "All %u screen hash checkpoints match.",
+                    hash_checkpoint_num);
+        archdep_vice_exit(hash_match_exit_code);
+    }
+}
+
+/*-----------------------------------------------------------------------*/
+
 int screenshot_record(void)
 {
     screenshot_t screenshot;
 
+    hash_frame++;
+    screenshot_hash_frame();
+
     if (recording_driver == NULL) {
         return 0;
     }
@@ -292,3 +436,193 @@ void screenshot_try_reopen(void)
     }
     reopen = 0;
 }
+
+/*-----------------------------------------------------------------------*/
+
+static int hash_checkpoint_compare(const void *a, const void *b)
+{
+    unsigned int frame_a = ((const screenshot_hash_checkpoint_t *)a)->frame;
+    unsigned int frame_b = ((const screenshot_hash_checkpoint_t *)b)->frame;
+
+    return (frame_a > frame_b) - (frame_a < frame_b);
+}
+
+static int screenshot_hash_load(const char *name)
+{
+    FILE *fd;
+    char line[256];
+    char *p, *end;
+    unsigned long frame, hash;
+    unsigned int lineno = 0;
+    unsigned int size = 0;
+
+    fd = fopen(name, MODE_READ_TEXT);
+    if (fd == NULL) {
+        log_error(LOG_DEFAULT, "Cannot open screen hash file `%s'.", name);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fd) != NULL) {
+        lineno++;
+        p = line;
+        while (isspace((unsigned char)*p)) {
+            p++;
+        }
+        if (*p == '\0' || *p == '#') {
+            continue;
+        }
+
+        frame = strtoul(p, &end, 10);
+        if (end == p || frame == 0 || frame > UINT_MAX) {
+            break;
+        }
+        p = end;
+        hash = strtoul(p, &end, 16);
+        if (end == p || hash > 0xffffffffUL) {
+            break;
+        }
+
+        if (hash_checkpoint_num == size) {
+            size = size ? size * 2 : 64;
+            hash_checkpoints = lib_realloc(hash_checkpoints,
+                                           size * sizeof(screenshot_hash_checkpoint_t));
+        }
+        hash_checkpoints[hash_checkpoint_num].frame = (unsigned int)frame;
+        hash_checkpoints[hash_checkpoint_num].hash = (uint32_t)hash;
+        hash_checkpoint_num++;
+    }
+
+    if (!feof(fd)) {
+        log_error(LOG_DEFAULT, "Invalid line %u in screen hash file `%s'.",
+                  lineno, name);
+        fclose(fd);
+        return -1;
+    }
+    fclose(fd);
+
+    qsort(hash_checkpoints, hash_checkpoint_num,
+          sizeof(screenshot_hash_checkpoint_t), hash_checkpoint_compare);
+
+    return 0;
+}
+
+/* -screenhash and -screenhashlog are only set from the command line, saved
+   names would make every later session exit at the checkpoints or overwrite
+   the log */
+static int hash_file_opt(const char *val, void *param)
+{
+    util_string_set(&hash_file_name, val);
+
+    lib_free(hash_checkpoints);
+    hash_checkpoints = NULL;
+    hash_checkpoint_num = 0;
+    hash_checkpoint_next = 0;
+
+    if (hash_file_name == NULL || *hash_file_name == '\0') {
+        return 0;
+    }
+
+    if (screenshot_hash_load(hash_file_name) < 0) {
+        lib_free(hash_checkpoints);
+        hash_checkpoints = NULL;
+        hash_checkpoint_num = 0;
+        return -1;
+    }
+
+    /* skip checkpoints for frames that already passed */
+    while (hash_checkpoint_next < hash_checkpoint_num
+           && hash_checkpoints[hash_checkpoint_next].frame <= hash_frame) {
+        hash_checkpoint_next++;
+    }
+
+    return 0;
+}
+
+static int hash_log_opt(const char *val, void *param)
+{
+    util_string_set(&hash_log_name, val);
+
+    if (hash_log_fd != NULL) {
+        fclose(hash_log_fd);
+        hash_log_fd = NULL;
+    }
+
+    if (hash_log_name == NULL || *hash_log_name == '\0') {
+        return 0;
+    }
+
+    hash_log_fd = fopen(hash_log_name, MODE_WRITE_TEXT);
+    if (hash_log_fd == NULL) {
+        log_error(LOG_DEFAULT, "Cannot open screen hash log `%s'.", hash_log_name);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int set_hash_exit_code(int val, void *param)
+{
+    if (val < 0 || val > 255) {
+        return -1;
+    }
+
+    *(int *)param = val;
+
+    return 0;
+}
+
+static const resource_int_t resources_int[] = {
+    { "ScreenHashMatchExitCode", 0, RES_EVENT_NO, NULL,
+      &hash_match_exit_code, set_hash_exit_code, &hash_match_exit_code },
+    { "ScreenHashMismatchExitCode", 1, RES_EVENT_NO, NULL,
+      &hash_mismatch_exit_code, set_hash_exit_code, &hash_mismatch_exit_code },
+    RESOURCE_INT_LIST_END
+};
+
+/** \brief  Register the screen hash resources
+ *
+ * \return  0 on success, -1 on error
+ */
+int screenshot_resources_init(void)
+{
+    return resources_register_int(resources_int);
+}
+
+/** \brief  Free the screen hash resources
+ */
+void screenshot_resources_shutdown(void)
+{
+    lib_free(hash_file_name);
+    hash_file_name = NULL;
+    lib_free(hash_log_name);
+    hash_log_name = NULL;
+    lib_free(hash_checkpoints);
+    hash_checkpoints = NULL;
+    hash_checkpoint_num = 0;
+}
+
+static const cmdline_option_t cmdline_options[] =
+{
+    { "-screenhash", CALL_FUNCTION, CMDLINE_ATTRIB_NEED_ARGS,
+      hash_file_opt, NULL, NULL, NULL,
+      "<Name>", "Check the screen against the (frame, hash) checkpoints in the given file and exit after the last one" },
+    { "-screenhashlog", CALL_FUNCTION, CMDLINE_ATTRIB_NEED_ARGS,
+      hash_log_opt, NULL, NULL, NULL,
+      "<Name>", "Write the screen hash of every frame to the given file" },
+    { "-screenhashmatch", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
+      NULL, NULL, "ScreenHashMatchExitCode", NULL,
+      "<value>", "Exit code when all screen hash checkpoints match" },
+    { "-screenhashmismatch", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
+      NULL, NULL, "ScreenHashMismatchExitCode", NULL,
+      "<value>", "Exit code when a screen hash checkpoint does not match" },
+    CMDLINE_LIST_END
+};
+
+/** \brief  Register the screen hash command line options
+ *
+ * \return  0 on success, -1 on error
+ */
+int screenshot_cmdline_options_init(void)
+{
+    return cmdline_register_options(cmdline_options);
+}
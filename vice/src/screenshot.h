@@ -133,6 +133,11 @@ extern void screenshot_stop_recording(void);
 extern int screenshot_is_recording(void);
 extern void screenshot_prepare_reopen(void);
 extern void screenshot_try_reopen(void);
+extern int screenshot_hash(struct video_canvas_s *canvas, uint32_t *hash);
+
+extern int screenshot_resources_init(void);
+extern void screenshot_resources_shutdown(void);
+extern int screenshot_cmdline_options_init(void);
 
 #ifdef FEATURE_CPUMEMHISTORY
 extern int memmap_screenshot_save(const char *drvname, const char *filename, int x_size, int y_size, uint8_t *gfx, uint8_t *palette);
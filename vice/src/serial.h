@@ -86,6 +86,7 @@ extern void serial_trap_init(uint16_t tmpin);
 extern int serial_trap_attention(void);
 extern int serial_trap_send(void);
 extern int serial_trap_receive(void);
+extern int serial_trap_load(void);
 extern int serial_trap_ready(void);
 extern void serial_traps_reset(void);
 extern void serial_trap_eof_callback_set(void (*func)(void));
@@ -56,6 +56,9 @@ static void serial_iec_device_exec_main(unsigned int devnr, CLOCK clk_value);
 
 static int iec_device_enabled[IECBUS_NUM];
 
+/* Number of devices with `serial_iec_device_state[].enabled' set.  */
+static unsigned int serial_iec_device_num_enabled = 0;
+
 static int set_iec_device_enable(int enable, void *param)
 {
     unsigned int unit;
@@ -207,6 +210,7 @@ void serial_iec_device_init(void)
         iecbus_device_write(i, (uint8_t)(IECBUS_DEVICE_WRITE_CLK | IECBUS_DEVICE_WRITE_DATA));
     }
 
+    serial_iec_device_num_enabled = 0;
     serial_iec_device_inited = 1;
 
     for (i = 0; i < IECBUS_NUM; i++) {
@@ -248,6 +252,7 @@ void serial_iec_device_enable(unsigned int devnr)
                     "serial_iec_device_enable(%i)", devnr);
 #endif
         serial_iec_device_state[devnr].enabled = 1;
+        serial_iec_device_num_enabled++;
         serial_iec_device_state[devnr].flags = 0;
         serial_iec_device_state[devnr].timeout = 0;
         memset(&serial_iec_device_state[devnr].st, 0, 15);
@@ -269,6 +274,7 @@ void serial_iec_device_disable(unsigned int devnr)
         iecbus_device_write(devnr, (uint8_t)(IECBUS_DEVICE_WRITE_CLK | IECBUS_DEVICE_WRITE_DATA));
         serial_iec_device_state[devnr].enabled = 0;
         serial_iec_device_state[devnr].timeout = 0;
+        serial_iec_device_num_enabled--;
     }
 }
 
@@ -277,6 +283,11 @@ void serial_iec_device_exec(CLOCK clk_value)
 {
     unsigned int i;
 
+    /* Called on every access to the IEC bus; usually there is no device.  */
+    if (serial_iec_device_num_enabled == 0) {
+        return;
+    }
+
     for (i = 0; i < IECBUS_NUM; i++) {
         if (serial_iec_device_state[i].enabled) {
             serial_iec_device_exec_main(i, clk_value);
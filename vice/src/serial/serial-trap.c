@@ -30,9 +30,12 @@
 
 #include <stdio.h> /* for NULL */
 
+#include "cmdline.h"
 #include "iecbus.h"
+#include "machine.h"
 #include "maincpu.h"
 #include "mem.h"
+#include "resources.h"
 #include "serial-iec-bus.h"
 /* Will be removed once serial.c is clean */
 #include "serial-iec-device.h"
@@ -53,6 +56,9 @@ extern int traps_enabled_device[MAX_DEVICES]; /* FIXME */
 /* Warning: these are only valid for the VIC20, C64 and C128, but *not* for
    the PET.  (FIXME?)  */
 #define BSOUR 0x95 /* Buffered Character for IEEE Bus */
+#define STATUS 0x90 /* Kernal I/O status word ST */
+#define VERCK 0x93 /* Flag: 0 = LOAD, 1 = VERIFY */
+#define EAL 0xae /* Pointer to the current LOAD/SAVE address */
 
 /* FIXME: code here assumes 4 bits for device number; should be 5? */
 #define DEVNR_MASK      0x0F    /* should be 0x1F */
@@ -88,6 +94,9 @@ static void (*attention_callback_func)(void);
 
 static unsigned int serial_truedrive[IECBUS_NUM];
 
+/* Flag: Load whole files at once in the Kernal LOAD trap.  */
+static int serial_direct_load = 0;
+
 #define IS_PRINTER(d)   (((d) & DEVNR_MASK) >= 4 && ((d) & DEVNR_MASK) <= 7)
 
 static void serial_set_st(uint8_t st)
@@ -275,6 +284,62 @@ int serial_trap_receive(void)
 }
 
 
+/* Kernal LOAD from a serial device, byte loop (F4F3 on the C64): read the
+   rest of the file in one go.  This does what the Kernal loop does for
+   every byte, except for checking the STOP key, and then continues with
+   the UNTALK that follows the loop.  */
+int serial_trap_load(void)
+{
+    uint16_t addr;
+    uint8_t data = 0;
+
+    if (!serial_direct_load
+        || mem_read(VERCK) != 0
+        || !device_uses_serial_traps(ActiveDevice)) {
+        return 0;
+    }
+
+    DBG(("serial_trap_load (TrapDevice 0x%02x)", TrapDevice));
+
+    if (TrapSecondary == 0) {
+        send_listen_talk_secondary(SECONDARY + 0);
+    }
+
+    addr = (uint16_t)(mem_read(EAL) | (mem_read(EAL + 1) << 8));
+
+    do {
+        mem_store(STATUS, (uint8_t)(serial_get_st() & 0xfd));
+        data = serial_iec_bus_read(TrapDevice, TrapSecondary, serial_set_st);
+        if (serial_get_st() & 0x02) {
+            /* Time out: leave the retry to the Kernal.  */
+            mem_store(EAL, (uint8_t)(addr & 0xff));
+            mem_store(EAL + 1, (uint8_t)(addr >> 8));
+            return 0;
+        }
+        mem_store(addr++, data);
+    } while (!(serial_get_st() & 0x40));
+
+    mem_store(tmp_in, data);
+    mem_store(EAL, (uint8_t)(addr & 0xff));
+    mem_store(EAL + 1, (uint8_t)(addr >> 8));
+
+    if (eof_callback_func != NULL) {
+        eof_callback_func();
+    }
+
+    /* Set registers like the Kernal loop leaves them.  */
+    maincpu_set_a(data);
+    maincpu_set_x(data);
+    maincpu_set_y(0);
+    maincpu_set_sign((serial_get_st() & 0x80) ? 1 : 0);
+    maincpu_set_overflow(1);    /* BIT ST with EOI set ends the loop */
+    maincpu_set_zero((data & serial_get_st()) ? 0 : 1);
+    maincpu_set_carry(0);
+    maincpu_set_interrupt(0);
+
+    return 1;
+}
+
 /* Kernal loops serial-port (0xdd00) to see when serial is ready: fake it.
    EEA9 Get serial data and clk in (TKSA subroutine).  */
 
@@ -294,15 +359,54 @@ int serial_trap_ready(void)
     return 1;
 }
 
+static int set_serial_direct_load(int val, void *param)
+{
+    serial_direct_load = val ? 1 : 0;
+
+    return 0;
+}
+
+static const resource_int_t resources_int[] = {
+    { "VirtualDeviceDirectLoad", 0, RES_EVENT_SAME, NULL,
+      &serial_direct_load, set_serial_direct_load, NULL },
+    RESOURCE_INT_LIST_END
+};
+
+static const cmdline_option_t cmdline_options[] =
+{
+    { "-virtualdevdirectload", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "VirtualDeviceDirectLoad", (resource_value_t)1,
+      NULL, "Load files from virtual devices at once in the Kernal LOAD trap" },
+    { "+virtualdevdirectload", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "VirtualDeviceDirectLoad", (resource_value_t)0,
+      NULL, "Load files from virtual devices byte by byte" },
+    CMDLINE_LIST_END
+};
+
+/* Only the C64 Kernal LOAD routine is trapped.  */
+static int serial_direct_load_available(void)
+{
+    return machine_class == VICE_MACHINE_C64
+           || machine_class == VICE_MACHINE_C64SC;
+}
+
 /* Initializing the IEC bus and IEC device will move once serial.c is not
    referenced by PET and CBM2 anymore. */
 int serial_resources_init(void)
 {
+    if (serial_direct_load_available()
+        && resources_register_int(resources_int) < 0) {
+        return -1;
+    }
     return serial_iec_device_resources_init();
 }
 
 int serial_cmdline_options_init(void)
 {
+    if (serial_direct_load_available()
+        && cmdline_register_options(cmdline_options) < 0) {
+        return -1;
+    }
     return serial_iec_device_cmdline_options_init();
 }
 
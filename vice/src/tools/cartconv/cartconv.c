@@ -1046,6 +1046,287 @@ static void printoptions(char *inputname, char *optionsname)
 
 /*****************************************************************************/
 
+/* batch validation of crt files (--check) */
+
+typedef struct check_result_s {
+    char *name;
+    unsigned long size;
+    unsigned long hash;
+    int index;
+    int duplicate;
+} check_result_t;
+
+/* FNV-1a, only used to sort candidates for identical files next to each
+   other. Different files can collide, so candidates are compared byte by
+   byte before they are reported. */
+static unsigned long check_hash(const unsigned char *data, unsigned long len)
+{
+    unsigned long hash = 2166136261UL;
+    unsigned long i;
+
+    for (i = 0; i < len; i++) {
+        hash = ((hash ^ data[i]) * 16777619UL) & 0xffffffffUL;
+    }
+    return hash;
+}
+
+static int compare_check_results(const void *op1, const void *op2)
+{
+    const check_result_t *p1 = (const check_result_t *)op1;
+    const check_result_t *p2 = (const check_result_t *)op2;
+
+    if (p1->hash != p2->hash) {
+        return (p1->hash < p2->hash) ? -1 : 1;
+    }
+    if (p1->size != p2->size) {
+        return (p1->size < p2->size) ? -1 : 1;
+    }
+    return p1->index - p2->index;
+}
+
+/* compare the contents of two files of the same size, returns 1 when they
+   are identical and 0 when they differ or can not be read */
+static int check_files_identical(const char *name1, const char *name2)
+{
+    unsigned char buf1[0x4000], buf2[0x4000];
+    FILE *f1, *f2;
+    size_t n1, n2;
+    int same = 0;
+
+    f1 = fopen(name1, "rb");
+    f2 = fopen(name2, "rb");
+    if ((f1 != NULL) && (f2 != NULL)) {
+        do {
+            n1 = fread(buf1, 1, sizeof(buf1), f1);
+            n2 = fread(buf2, 1, sizeof(buf2), f2);
+            if ((n1 != n2) || memcmp(buf1, buf2, n1)) {
+                break;
+            }
+        } while (n1 == sizeof(buf1));
+        same = (n1 == n2) && (n1 < sizeof(buf1)) && !ferror(f1) && !ferror(f2);
+    }
+    if (f1 != NULL) {
+        fclose(f1);
+    }
+    if (f2 != NULL) {
+        fclose(f2);
+    }
+    return same;
+}
+
+/* validate the header and CHIP packets of a crt file held in memory,
+   returns 0 when ok, 1 on warnings and 2 on errors. */
+static int check_crt_image(const unsigned char *data, unsigned long len,
+                           int *crtid, unsigned int *chips,
+                           unsigned long *datasize, const char **msg)
+{
+    const cart_t *info = NULL;
+    unsigned long pos, chunklen, size;
+    int machine = -1;
+    int last = -1;
+    int result = 0;
+
+    *crtid = -1;
+    *chips = 0;
+    *datasize = 0;
+    *msg = "";
+
+    if (len < CRT_HEADER_LEN) {
+        *msg = "file too short for a crt header";
+        return 2;
+    }
+    if (!memcmp("C64 CARTRIDGE   ", data, 16)) {
+        machine = VICE_MACHINE_C64;
+        last = CARTRIDGE_LAST;
+    } else if (!memcmp("C128 CARTRIDGE  ", data, 16)) {
+        machine = VICE_MACHINE_C128;
+        last = CARTRIDGE_C128_LAST;
+    } else if (!memcmp("VIC20 CARTRIDGE ", data, 16)) {
+        machine = VICE_MACHINE_VIC20;
+        last = CARTRIDGE_VIC20_LAST;
+    } else if (!memcmp("PLUS4 CARTRIDGE ", data, 16)) {
+        machine = VICE_MACHINE_PLUS4;
+        last = CARTRIDGE_PLUS4_LAST;
+    } else {
+        *msg = "not a crt file";
+        return 2;
+    }
+
+    if (data[0x10] != 0 || data[0x11] != 0 || data[0x12] != 0 ||
+        data[0x13] != CRT_HEADER_LEN) {
+        *msg = "illegal header size";
+        result = 1;
+    }
+
+    *crtid = data[0x17] + (data[0x16] << 8);
+    if (data[0x17] & 0x80) {
+        /* handle our negative test IDs */
+        *crtid -= 0x10000;
+    }
+    if ((*crtid < 0) || (*crtid > last) ||
+        ((info = find_cartinfo_from_crtid(*crtid, machine)) == NULL)) {
+        *msg = "unknown crt id";
+        return 2;
+    }
+
+    if ((machine == VICE_MACHINE_C64) && *crtid) {
+        if (data[CRT_HEADER_EXROM] != info->exrom ||
+            data[CRT_HEADER_GAME] != info->game) {
+            *msg = "exrom/game set incorrectly";
+            result = 1;
+        }
+    }
+
+    pos = CRT_HEADER_LEN;
+    while (pos < len) {
+        const unsigned char *b = data + pos;
+
+        if ((len - pos) < CRT_CHIP_HEADER_LEN) {
+            *msg = "truncated CHIP header";
+            return 2;
+        }
+        if (b[CRT_CHIP_OFFS_C] != 'C' || b[CRT_CHIP_OFFS_H] != 'H' ||
+            b[CRT_CHIP_OFFS_I] != 'I' || b[CRT_CHIP_OFFS_P] != 'P') {
+            *msg = "CHIP tag not found";
+            return 2;
+        }
+        chunklen = ((unsigned long)b[4] << 24) + ((unsigned long)b[5] << 16) +
+                   ((unsigned long)b[6] << 8) + b[7];
+        size = (unsigned long)(b[CRT_CHIP_OFFS_SIZE_HI] << 8) + b[CRT_CHIP_OFFS_SIZE_LO];
+        if ((size + CRT_CHIP_HEADER_LEN) > chunklen) {
+            *msg = "data size exceeds chunk length";
+            return 2;
+        }
+        if (chunklen > (len - pos)) {
+            *msg = "chunk exceeds end of file";
+            return 2;
+        }
+        if (((b[CRT_CHIP_OFFS_TYPE_HI] << 8) + b[CRT_CHIP_OFFS_TYPE_LO]) > CRT_CHIP_TYPES_MAX) {
+            *msg = "invalid chip type";
+            result = 1;
+        }
+        if ((size + CRT_CHIP_HEADER_LEN) < chunklen) {
+            *msg = "chunk length exceeds data size";
+            result = 1;
+        }
+        pos += chunklen;
+        *datasize += size;
+        (*chips)++;
+    }
+
+    if (*chips == 0) {
+        *msg = "no CHIP packets";
+        return 2;
+    }
+    return result;
+}
+
+/* check all given files, print one tab separated line per file and finally
+   one line per file that is identical to an earlier one:
+
+   ok|warning|error <file> <crt id> <chips> <data size> <hash> <message>
+   duplicate <file> <first file>
+
+   returns the exit code, nonzero if any file had errors. */
+static int check_crt_files(int num, char **names)
+{
+    static const char *status[3] = { "ok", "warning", "error" };
+    check_result_t *results;
+    unsigned char *data = NULL;
+    unsigned long datalen = 0;
+    int i, j, errors = 0;
+
+    results = malloc(sizeof(check_result_t) * (num > 0 ? num : 1));
+    if (results == NULL) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+
+    for (i = 0; i < num; i++) {
+        FILE *f;
+        long len;
+        int crtid = -1, res;
+        unsigned int chips = 0;
+        unsigned long size = 0;
+        const char *msg;
+
+        results[i].name = names[i];
+        results[i].index = i;
+        results[i].size = 0;
+        results[i].hash = 0;
+        results[i].duplicate = 0;
+
+        /* read every file once, with a single read into a reused buffer */
+        f = fopen(names[i], "rb");
+        if ((f == NULL) || fseek(f, 0, SEEK_END) || ((len = ftell(f)) < 0) ||
+            fseek(f, 0, SEEK_SET)) {
+            printf("error\t%s\t-1\t0\t0\t00000000\tcan not open file\n", names[i]);
+            if (f != NULL) {
+                fclose(f);
+            }
+            errors++;
+            continue;
+        }
+        if ((unsigned long)len > datalen) {
+            unsigned char *p = realloc(data, len);
+            if (p == NULL) {
+                fprintf(stderr, "Error: out of memory\n");
+                fclose(f);
+                free(data);
+                free(results);
+                return 1;
+            }
+            data = p;
+            datalen = (unsigned long)len;
+        }
+        if (fread(data, 1, len, f) != (size_t)len) {
+            printf("error\t%s\t-1\t0\t0\t00000000\tcan not read file\n", names[i]);
+            fclose(f);
+            errors++;
+            continue;
+        }
+        fclose(f);
+
+        results[i].size = (unsigned long)len;
+        results[i].hash = check_hash(data, (unsigned long)len);
+
+        res = check_crt_image(data, (unsigned long)len, &crtid, &chips, &size, &msg);
+        if (res == 2) {
+            errors++;
+        }
+        printf("%s\t%s\t%d\t%u\t%lu\t%08lx\t%s\n", status[res], names[i], crtid,
+               chips, size, results[i].hash, msg);
+    }
+
+    /* sort by hash and size, so candidates for identical files end up next
+       to each other with the earliest one first. Within a run every file is
+       compared against the earlier files that are not duplicates themselves,
+       so a hash collision is never reported as a duplicate. */
+    qsort(results, num, sizeof(check_result_t), compare_check_results);
+    for (i = 0; i < num; i = j) {
+        for (j = i + 1; (j < num) && (results[i].size != 0) &&
+             (results[j].hash == results[i].hash) &&
+             (results[j].size == results[i].size); j++) {
+            int k;
+
+            for (k = i; k < j; k++) {
+                if (!results[k].duplicate &&
+                    check_files_identical(results[k].name, results[j].name)) {
+                    printf("duplicate\t%s\t%s\n", results[j].name, results[k].name);
+                    results[j].duplicate = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    free(data);
+    free(results);
+    return errors ? 1 : 0;
+}
+
+/*****************************************************************************/
+
 typedef struct sorted_cart_s {
     char *opt;
     char *name;
@@ -1183,7 +1464,8 @@ static void usage(void)
 {
     cleanup();
     printf("convert:    cartconv [-r] [-q|-v] [-t cart type] [-s cart revision] -i \"input name\" -o \"output name\" [-n \"cart name\"] [-l load address]\n");
-    printf("print info: cartconv [-r] [-q|-v] -f \"input name\"\n\n");
+    printf("print info: cartconv [-r] [-q|-v] -f \"input name\"\n");
+    printf("check:      cartconv --check \"input name\" [\"input name\" ...]\n\n");
     printf("-f <name>                   print info on file\n");
     printf("-r                          repair mode (accept broken/invalid input files)\n");
     printf("-p                          accept non padded binaries as input\n");
@@ -1199,6 +1481,7 @@ static void usage(void)
     printf("--types                     show the supported cart types\n");
     printf("--version                   print cartconv version\n");
     printf("--options-file <filename>   write options for reverting the conversion into a file (for test script)\n");
+    printf("--check <name> [<name> ...] validate crt files and report duplicates, one line per file\n");
     exit(1);
 }
 
@@ -1438,6 +1721,15 @@ int main(int argc, char *argv[])
         input_filename[i] = NULL;
     }
 
+    /* all remaining arguments are files to check */
+    if (!strcmp(argv[1], "--check")) {
+        if (argc - 2 == 0) {
+            fprintf(stderr, "Error: no input filename\n");
+            usage();
+        }
+        return check_crt_files(argc - 2, &argv[2]);
+    }
+
     while (arg_counter < argc) {
         flag = argv[arg_counter];
         argument = (arg_counter + 1 < argc) ? argv[arg_counter + 1] : NULL;
@@ -945,6 +945,8 @@ int main(int argc, char **argv)
     int ctrls = -1, hdr = -1, show_words = 0;
     int fil = 0, outf = 0, overwrt = 0, textmode = 0;
     int flg = 0;                            /* files on stdin */
+    int batch = 0;                          /* one output file per input */
+    char *batchname = NULL;
 
     /* Parse arguments */
     progname = argv[0];
@@ -1022,6 +1024,9 @@ int main(int argc, char **argv)
         } else if (!strcmp(argv[0], "-text")) {   /* force text mode */
             ++textmode;
             continue;
+        } else if (!strcmp(argv[0], "-batch")) {  /* output file per input */
+            ++batch;
+            continue;
         } else if (!strcmp(argv[0], "-help") || !strncmp(argv[0], "-?", 2)) {  /* version ID */
             /* Fall to error for Usage */
 
@@ -1053,6 +1058,14 @@ int main(int argc, char **argv)
         fil++;
     }
 
+    if (batch) {
+        if (!fil || outf) {
+            fprintf(stderr, "\n%s: -batch needs input files and no -o\n", progname);
+            exit(1);
+        }
+        ++outf;
+    }
+
     if (hdr == -1) {
         hdr = outf ? 0 : 1;
     }
@@ -1155,6 +1168,23 @@ int main(int argc, char **argv)
         }
 
 
+        if (batch) {
+            /* name the output after the input, e.g. foo.prg -> foo.prg.txt */
+            const char *ext = wr_mode ? (textmode ? ".seq" : ".prg") : ".txt";
+
+            batchname = malloc(strlen(argv[0]) + strlen(ext) + 1);
+            if (batchname == NULL) {
+                fprintf(stderr, "\n%s: out of memory\n", progname);
+                exit(1);
+            }
+            strcpy(batchname, argv[0]);
+            strcat(batchname, ext);
+            outfilename = batchname;
+            if (verbose) {
+                fprintf(stderr, "%s -> %s\n", argv[0], outfilename);
+            }
+        }
+
         if (!outf) {
             dest = stdout;
         } else {
@@ -1220,6 +1250,10 @@ int main(int argc, char **argv)
         if (outf) {
             fclose(dest);
         }
+        if (batchname != NULL) {
+            free(batchname);
+            batchname = NULL;
+        }
     } while (flg || (fil && --argc && ++argv));           /* next file */
     return(0);
 }
@@ -1267,7 +1301,7 @@ void usage(char *progname)
 
     fprintf(stdout,
             "\nUsage: %7s  [-c | -nc]  [-h | -nh]  [-text | -<version> | -w<version>]"
-            "\n\t\t[-skip <bytes>] [-l <hex>]  [--] [file list]\n\t\t[-k[<version>]]\n",
+            "\n\t\t[-skip <bytes>] [-l <hex>]  [-batch]  [--] [file list]\n\t\t[-k[<version>]]\n",
             progname);
 
     fprintf(stdout, "\n"
@@ -1292,6 +1326,8 @@ void usage(char *progname)
             "   -l\t\tSpecify load address for program (in hex, no leading chars!).\n");
     fprintf(stdout,
             "   -o <name>\tSpecify the output file name\n"
+            "   -batch\tWrite each input file to its own output file, named\n"
+            "   \t\tafter the input with .txt, .prg or .seq appended\n"
             "   -f\t\tForce overwritten the output file\n"
             "   \t\tThe default depends on the BASIC version.\n");
 
@@ -1317,6 +1353,10 @@ void usage(char *progname)
             "\tpetcat -text -w2 -o outputfile.seq -- inputfile.txt\n"
             "\t\tConvert inputfile.txt to a Petscii text SEQ file\n"
             "\t\tin outputfile.seq.\n");
+    fprintf(stdout,
+            "\tpetcat -2 -batch -- *.prg\n"
+            "\t\tDe-tokenize every .prg file in one run, writing\n"
+            "\t\tfoo.prg.txt for foo.prg and so on.\n");
 }
 
 
@@ -2408,6 +2448,16 @@ static int sstrcmp_codes(unsigned char *line, const char **wordlist, int token,
     for (; token < maxitems; token++) {
         DBG(("compare '%s' vs  '%s' - %u %u\n", wordlist[token], line, j, kwlen));
 
+        /* a match needs at least the first character, so reject most of
+           the list without entering the compare loops below */
+        if (codesnocase) {
+            if (tolower(*wordlist[token]) != tolower(*line)) {
+                continue;
+            }
+        } else if (*wordlist[token] != (char)*line) {
+            continue;
+        }
+
         if (codesnocase) {
             for (p = wordlist[token], q = (char *)line, j = 0;
                  *p && *q && (tolower(*p) == tolower(*q));
@@ -2443,6 +2493,11 @@ static unsigned char sstrcmp(unsigned char *line, const char **wordlist, int tok
     kwlen = 1;
     /* search for keyword */
     for (; token < maxitems; token++) {
+        /* neither exact nor abbreviated keywords can match unless the
+           first character does */
+        if (*wordlist[token] != (char)*line) {
+            continue;
+        }
         for (p = wordlist[token], q = (char *)line, j = 0;
              *p && *q && *p == *q; p++, q++, j++) {}
 
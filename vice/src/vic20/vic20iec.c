@@ -31,6 +31,7 @@
 #include <stdio.h>
 
 #include "cia.h"
+#include "debug.h"
 #include "drive.h"
 #include "drivetypes.h"
 #include "iecbus.h"
@@ -55,6 +56,20 @@ static uint8_t drive_atna[NUM_DISK_UNITS], drive_data_modifier[NUM_DISK_UNITS];
 static uint8_t bus_data, bus_clock, bus_atn;
 static uint8_t cpu_bus_val;
 
+/* record the bus lines and the computer outputs after the computer changed
+   its outputs, changes caused by the drives are recorded by the drives */
+static void iec_trace_bus(void)
+{
+    static uint32_t old_cpu_state = 0xffffffff;
+    uint32_t cpu_state = (cpu_data << 8) | (cpu_clock << 9) | (cpu_atn << 10);
+
+    if (cpu_state != old_cpu_state) {
+        old_cpu_state = cpu_state;
+        debug_bustrace(DEBUG_BUSTRACE_IEC, 0, DEBUG_BUSTRACE_COMPUTER,
+                       bus_data | (bus_clock << 1) | (bus_atn << 2) | cpu_state);
+    }
+}
+
 static inline void resolve_bus_signals(void)
 {
     unsigned int i;
@@ -70,6 +85,7 @@ static inline void resolve_bus_signals(void)
         bus_data &= unit->enable ? NOT(drive_data[i])
                     & NOT(drive_data_modifier[i]) : 0x01;
     }
+
 }
 
 void iec_update_ports(void)
@@ -115,6 +131,14 @@ void iec_drive_write(uint8_t data, unsigned int dnr)
     drive_atna[dnr] = ((data & 16) >> 4);
     iec_calculate_data_modifier(dnr);
     resolve_bus_signals();
+
+    if (debug.bustrace) {
+        /* drive outputs in bits 0-2, the resulting bus lines in bits 8-10 */
+        debug_bustrace(DEBUG_BUSTRACE_IEC, dnr + 8, DEBUG_BUSTRACE_DRIVE,
+                       drive_data[dnr] | (drive_clock[dnr] << 1)
+                       | (drive_atna[dnr] << 2) | (bus_data << 8)
+                       | (bus_clock << 9) | (bus_atn << 10));
+    }
 }
 
 uint8_t iec_drive_read(unsigned int dnr)
@@ -210,6 +234,10 @@ void iec_pa_write(uint8_t data)
     }
 
     resolve_bus_signals();
+
+    if (debug.bustrace) {
+        iec_trace_bus();
+    }
 }
 
 
@@ -232,6 +260,10 @@ void iec_pcr_write(uint8_t data)
     }
 
     resolve_bus_signals();
+
+    if (debug.bustrace) {
+        iec_trace_bus();
+    }
 }
 
 void iec_fast_drive_write(uint8_t data, unsigned int dnr)
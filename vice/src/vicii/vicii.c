@@ -126,6 +126,15 @@ void vicii_set_phi2_chargen_addr_options(uint16_t mask, uint16_t value)
 
 void vicii_set_chargen_addr_options(uint16_t mask, uint16_t value)
 {
+    /* The C128 MMU sets this on every configuration change, mostly to the
+       same values; the memory pointers then would not change either. */
+    if (vicii.vaddr_chargen_mask_phi1 == mask
+        && vicii.vaddr_chargen_value_phi1 == value
+        && vicii.vaddr_chargen_mask_phi2 == mask
+        && vicii.vaddr_chargen_value_phi2 == value) {
+        return;
+    }
+
     vicii.vaddr_chargen_mask_phi1 = mask;
     vicii.vaddr_chargen_value_phi1 = value;
     vicii.vaddr_chargen_mask_phi2 = mask;
@@ -276,6 +276,11 @@ static CLOCK last_sync_clk;
 
 static tick_t sync_target_tick;
 
+/* Emulated cycles between host checks in vsync_do_end_of_line(), and the
+   clock of the last check. Keeps the per-line cost down to a subtraction. */
+static CLOCK line_check_interval_clk = 1;
+static CLOCK last_line_check_clk;
+
 static int timer_speed = 0;
 static bool sync_reset = true;
 static bool metrics_reset = false;
@@ -315,6 +320,13 @@ void vsync_set_machine_parameter(double refresh, long cycles)
     refresh_frequency = refresh;
     cycles_per_sec = cycles;
     cycles_per_frame = (double)cycles / refresh;
+
+    /* look at the host (sound, clock) about four times per millisecond */
+    line_check_interval_clk = (CLOCK)(cycles / 4000);
+    if (line_check_interval_clk < 1) {
+        line_check_interval_clk = 1;
+    }
+
     set_timer_speed(relative_speed);
 }
 
@@ -513,6 +525,19 @@ void vsync_do_end_of_line(void)
         return;
     }
 
+    /*
+     * Most lines have nothing to do: the host is only synced every 2 ms,
+     * and sound is written in whole fragments. Skip the sound flush and the
+     * host clock read until enough emulated cycles have passed. A clock that
+     * went backwards (reset, snapshot) wraps to a big delta and checks now.
+     */
+
+    if (!sync_reset && !update_thread_priority
+        && main_cpu_clock - last_line_check_clk < line_check_interval_clk) {
+        return;
+    }
+    last_line_check_clk = main_cpu_clock;
+
     /* deal with any accumulated sound immediately */
     tick_based_sync_timing = sound_flush();
 